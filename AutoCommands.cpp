@@ -0,0 +1,100 @@
+/*
+ * AutoCommands.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "AutoCommands.h"
+#include "Robot.h"
+
+bool DriveProfileCommand::Execute()
+{
+	if(!Bot->ProfileRunning()) return true;
+	Bot->ExecuteProfile();
+	return false;
+}
+
+void DriveProfileCommand::End(bool interrupted)
+{
+	if(!interrupted) return;
+	Bot->StopDriveLoop();
+	IO->SetDrive(0.0,0.0);
+}
+
+bool ArmLoweredCommand::Execute()
+{
+	return Bot->ArmLowered(Height);
+}
+
+void ArmLoweredCommand::End(bool interrupted)
+{
+	if(interrupted) IO->SetArm(0.0);
+}
+
+bool LiftAndArmCommand::Execute()
+{
+	return Bot->LiftRaisedToUpperLimitAndArmLowered(Height);
+}
+
+void LiftAndArmCommand::End(bool interrupted)
+{
+	if(!interrupted) return;
+	IO->SetLift(0.0);
+	IO->SetArm(0.0);
+}
+
+bool EjectCommand::Execute()
+{
+	return Bot->EjectCrate(Seconds,Speed);
+}
+
+void EjectCommand::End(bool interrupted)
+{
+	if(interrupted) IO->SetGrip(0.0);
+}
+
+bool WaitDistanceCommand::Execute()
+{
+	return fabs(Bot->GetDistance()) >= Distance;
+}
+
+void ScriptCommand::Load(const AutoScript *script, int layout)
+{
+	ActionCount = script->GetActions(layout,Actions,AutoScript::kMaxOps);
+}
+
+bool ScriptCommand::RunAction(const ScriptOp &action)
+{
+	switch(action.Code)
+	{
+		case kScriptArm:
+			return Bot->ArmLowered(action.Args[0]);
+		case kScriptLift:
+			return Bot->LiftRaisedToUpperLimitAndArmLowered(action.Args[0]);
+		case kScriptEject:
+			return Bot->EjectCrate(action.Args[0],action.Args[1]);
+		default:
+			return true;
+	}
+}
+
+bool ScriptCommand::Execute()
+{
+	TASK_BEGIN();
+	TASK_RUN(Drive);
+	for(Action = 0; Action < ActionCount; Action++)
+	{
+		Timer->Reset();
+		TASK_AWAIT(RunAction(*Actions[Action]));
+	}
+	TASK_END();
+}
+
+void ScriptCommand::End(bool interrupted)
+{
+	TaskCommand::End(interrupted);
+	if(!interrupted) return;
+	IO->SetLift(0.0);
+	IO->SetArm(0.0);
+	IO->SetGrip(0.0);
+}
@@ -0,0 +1,112 @@
+/*
+ * AutoCommands.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  The autonomous steps as Commands (Command.h), each one a wrapper of the
+ *  Robot helper that did the step in the AutoState routines.  Robot builds
+ *  them once in BuildRoutines and groups them into the thumbwheel routines.
+ *
+ */
+
+#ifndef SRC_AUTOCOMMANDS_H_
+#define SRC_AUTOCOMMANDS_H_
+
+#include "Command.h"
+#include "RobotIO.h"
+#include "AutoScript.h"
+
+class Robot;
+
+//the plan picked at AutonomousInit
+class DriveProfileCommand : public Command
+{
+private:
+	Robot *Bot;
+	RobotIO *IO;
+public:
+	DriveProfileCommand(Robot *robot, RobotIO *io) : Command(kSubsystemDrive), Bot(robot), IO(io) {}
+	bool Execute();
+	void End(bool interrupted);
+};
+
+//Robot::ArmLowered
+class ArmLoweredCommand : public Command
+{
+private:
+	Robot *Bot;
+	RobotIO *IO;
+	double Height;
+public:
+	ArmLoweredCommand(Robot *robot, RobotIO *io, double height) :
+		Command(kSubsystemArm), Bot(robot), IO(io), Height(height) {}
+	bool Execute();
+	void End(bool interrupted);
+};
+
+//Robot::LiftRaisedToUpperLimitAndArmLowered
+class LiftAndArmCommand : public Command
+{
+private:
+	Robot *Bot;
+	RobotIO *IO;
+	double Height;
+public:
+	LiftAndArmCommand(Robot *robot, RobotIO *io, double height) :
+		Command(kSubsystemLift | kSubsystemArm), Bot(robot), IO(io), Height(height) {}
+	bool Execute();
+	void End(bool interrupted);
+};
+
+//Robot::EjectCrate, timed by the timer EjectCrate reads
+class EjectCommand : public Command
+{
+private:
+	Robot *Bot;
+	RobotIO *IO;
+	IOTimer *Timer;
+	double Seconds;
+	double Speed;
+public:
+	EjectCommand(Robot *robot, RobotIO *io, IOTimer *timer, double seconds, double speed) :
+		Command(kSubsystemGrip), Bot(robot), IO(io), Timer(timer), Seconds(seconds), Speed(speed) {}
+	void Initialize() { Timer->Reset(); }
+	bool Execute();
+	void End(bool interrupted);
+};
+
+//waits until the robot has driven a distance (either way) since the encoders were zeroed
+class WaitDistanceCommand : public Command
+{
+private:
+	Robot *Bot;
+	double Distance;
+public:
+	WaitDistanceCommand(Robot *robot, double distance) : Bot(robot), Distance(distance) {}
+	bool Execute();
+};
+
+//thumbwheel 7, drives the script's plan then runs its mechanism commands in order
+class ScriptCommand : public TaskCommand
+{
+private:
+	Robot *Bot;
+	RobotIO *IO;
+	IOTimer *Timer;
+	Command *Drive;
+	const ScriptOp *Actions[AutoScript::kMaxOps];
+	int ActionCount = 0;
+	int Action = 0;
+
+	bool RunAction(const ScriptOp &action);
+public:
+	ScriptCommand(Robot *robot, RobotIO *io, IOTimer *timer, Command *drive) :
+		TaskCommand(kSubsystemDrive | kSubsystemLift | kSubsystemArm | kSubsystemGrip),
+		Bot(robot), IO(io), Timer(timer), Drive(drive) {}
+	//take the mechanism commands of a game data layout, call before it is scheduled
+	void Load(const AutoScript *script, int layout);
+	bool Execute();
+	void End(bool interrupted);
+};
+
+#endif /* SRC_AUTOCOMMANDS_H_ */
@@ -0,0 +1,387 @@
+/*
+ * AutoScript.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "AutoScript.h"
+#include "Profile.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const struct
+{
+	const char *Name;
+	ScriptOpcode Code;
+	int ArgCount;
+} ScriptCommands[] =
+{
+	{"SPEED",kScriptSpeed,2},
+	{"MOVE",kScriptMove,1},
+	{"CURVE",kScriptCurve,2},
+	{"TURN",kScriptTurn,2},
+	{"PAUSE",kScriptPause,1},
+	{"ARM",kScriptArm,1},
+	{"LIFT",kScriptLift,1},
+	{"EJECT",kScriptEject,2},
+	{"IF",kScriptIf,0},
+	{"ELSE",kScriptElse,0},
+	{"END",kScriptEnd,0},
+};
+
+struct ScriptHeader
+{
+	uint32_t Magic;
+	uint16_t Version;
+	uint16_t OpCount;
+};
+
+static bool IsDriveOp(const ScriptOp &op)
+{
+	return op.Code <= kScriptPause;
+}
+
+//why an op read from a binary script is not one Parse could have made, NULL if it is
+static const char *CheckOp(const ScriptOp &op)
+{
+	if(op.Code > kScriptEnd) return "unknown command";
+	int argCount = 0;
+	for(const auto &command : ScriptCommands)
+		if(command.Code == op.Code) argCount = command.ArgCount;
+	if(op.ArgCount != argCount) return "wrong number of arguments";
+	for(int i = 0; i < 2; i++)
+	{
+		if(i < argCount && !std::isfinite(op.Args[i])) return "bad number";
+		if(i >= argCount && op.Args[i] != 0.0) return "extra argument";
+	}
+	if(op.Code == kScriptIf)
+	{
+		if(op.Plate != kScriptSwitch && op.Plate != kScriptScale) return "IF needs SWITCH or SCALE";
+		if(op.Side != 'L' && op.Side != 'R') return "IF needs a side, L or R";
+	}
+	else if(op.Plate != kScriptSwitch || op.Side != 'L') return "plate on a command other than IF";
+	return NULL;
+}
+
+static bool IsSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+//next word of the line, upper cased into word, returns its length, 0 at the end
+//of the line or -1 if it does not fit in word (a cut off word could still parse)
+static int NextWord(const char *&p, const char *end, char *word, int size)
+{
+	while(p < end && IsSpace(*p)) p++;
+	if(p == end) return 0;
+	int n = 0;
+	while(p < end && !IsSpace(*p))
+	{
+		char c = *p++;
+		if(c >= 'a' && c <= 'z') c -= 'a' - 'A';
+		if(n == size - 1) return -1;
+		word[n++] = c;
+	}
+	word[n] = 0;
+	return n;
+}
+
+//[-]digits[.digits], digits / 10^decimals so 41.3 comes out as the literal would
+static bool ParseNumber(const char *word, double *value)
+{
+	bool negative = *word == '-';
+	if(*word == '-' || *word == '+') word++;
+	double mantissa = 0.0, divisor = 1.0;
+	bool digits = false, point = false;
+	for(; *word != 0; word++)
+	{
+		if(*word == '.' && !point) point = true;
+		else if(*word >= '0' && *word <= '9')
+		{
+			mantissa = mantissa * 10 + (*word - '0');
+			if(point) divisor *= 10;
+			digits = true;
+		}
+		else return false;
+	}
+	if(!digits) return false;
+	*value = (negative ? -mantissa : mantissa) / divisor;
+	return true;
+}
+
+AutoScript::AutoScript()
+{
+	Error[0] = 0;
+}
+
+int AutoScript::Fail(int line, const char *message)
+{
+	snprintf(Error,sizeof(Error),"line %i: %s",line,message);
+	ErrorLine = line;
+	OpCount = 0;
+	return -1;
+}
+
+int AutoScript::Parse(const char *text, int length)
+{
+	OpCount = 0;
+	Error[0] = 0;
+	const char *end = text + length;
+	int line = 0;
+	while(text < end)
+	{
+		line++;
+		const char *lineEnd = (const char *)memchr(text,'\n',end - text);
+		if(lineEnd == NULL) lineEnd = end;
+		const char *comment = (const char *)memchr(text,'#',lineEnd - text);
+		const char *p = text;
+		const char *stop = comment != NULL ? comment : lineEnd;
+		text = lineEnd + 1;
+
+		char word[16];
+		int length = NextWord(p,stop,word,sizeof(word));
+		if(length < 0) return Fail(line,"word too long");
+		if(length == 0) continue;
+		int command = -1;
+		for(int i = 0; i < int(sizeof(ScriptCommands) / sizeof(ScriptCommands[0])); i++)
+			if(strcmp(word,ScriptCommands[i].Name) == 0) command = i;
+		if(command < 0) return Fail(line,"unknown command");
+		if(OpCount == kMaxOps) return Fail(line,"too many commands");
+
+		ScriptOp &op = Ops[OpCount];
+		op = ScriptOp();
+		op.Code = ScriptCommands[command].Code;
+		op.Line = line;
+		if(op.Code == kScriptIf)
+		{
+			length = NextWord(p,stop,word,sizeof(word));
+			if(length < 0) return Fail(line,"word too long");
+			if(length == 0) return Fail(line,"IF needs SWITCH or SCALE");
+			if(strcmp(word,"SWITCH") == 0) op.Plate = kScriptSwitch;
+			else if(strcmp(word,"SCALE") == 0) op.Plate = kScriptScale;
+			else return Fail(line,"IF needs SWITCH or SCALE");
+			length = NextWord(p,stop,word,sizeof(word));
+			if(length < 0) return Fail(line,"word too long");
+			if(length == 0 || (strcmp(word,"L") != 0 && strcmp(word,"R") != 0))
+				return Fail(line,"IF needs a side, L or R");
+			op.Side = word[0];
+		}
+		else
+		{
+			for(int i = 0; i < ScriptCommands[command].ArgCount; i++)
+			{
+				double value;
+				length = NextWord(p,stop,word,sizeof(word));
+				if(length < 0) return Fail(line,"word too long");
+				if(length == 0) return Fail(line,"missing argument");
+				if(!ParseNumber(word,&value)) return Fail(line,"bad number");
+				op.Args[i] = value;
+				op.ArgCount++;
+			}
+		}
+		length = NextWord(p,stop,word,sizeof(word));
+		if(length < 0) return Fail(line,"word too long");
+		if(length > 0) return Fail(line,"extra argument");
+		OpCount++;
+	}
+	return Check();
+}
+
+int AutoScript::Check()
+{
+	int depth = 0;
+	bool hasElse[kMaxDepth] = {};
+	for(int i = 0; i < OpCount; i++)
+	{
+		const ScriptOp &op = Ops[i];
+		switch(op.Code)
+		{
+			case kScriptIf:
+				if(depth == kMaxDepth) return Fail(op.Line,"IFs nested too deep");
+				hasElse[depth++] = false;
+				break;
+			case kScriptElse:
+				if(depth == 0 || hasElse[depth-1]) return Fail(op.Line,"ELSE without IF");
+				hasElse[depth-1] = true;
+				break;
+			case kScriptEnd:
+				if(depth == 0) return Fail(op.Line,"END without IF");
+				depth--;
+				break;
+		}
+	}
+	if(depth > 0) return Fail(OpCount > 0 ? Ops[OpCount-1].Line : 0,"IF without END");
+	//the mechanism commands run after the drive, a drive command after one would be out of order
+	for(int layout = 0; layout < kLayouts; layout++)
+	{
+		const ScriptOp *ops[kMaxOps];
+		int count = Resolve(layout,ops,kMaxOps);
+		bool action = false;
+		for(int i = 0; i < count; i++)
+		{
+			if(!IsDriveOp(*ops[i])) action = true;
+			else if(action) return Fail(ops[i]->Line,"drive command after a mechanism command");
+		}
+	}
+	return OpCount;
+}
+
+int AutoScript::Resolve(int layout, const ScriptOp **ops, int maxOps) const
+{
+	//active[d] is true if the commands at depth d run for this layout
+	bool active[kMaxDepth + 1] = {true};
+	bool taken[kMaxDepth + 1] = {};
+	int depth = 0;
+	int count = 0;
+	for(int i = 0; i < OpCount; i++)
+	{
+		const ScriptOp &op = Ops[i];
+		switch(op.Code)
+		{
+			case kScriptIf:
+			{
+				bool right = (layout >> op.Plate) & 1;
+				taken[depth + 1] = (op.Side == 'R') == right;
+				active[depth + 1] = active[depth] && taken[depth + 1];
+				depth++;
+				break;
+			}
+			case kScriptElse:
+				active[depth] = active[depth-1] && !taken[depth];
+				break;
+			case kScriptEnd:
+				depth--;
+				break;
+			default:
+				if(active[depth] && count < maxOps) ops[count++] = &op;
+				break;
+		}
+	}
+	return count;
+}
+
+int AutoScript::GetLayout(const std::string &gameData)
+{
+	int layout = 0;
+	if(gameData.length() > 0 && gameData[0] == 'R') layout |= 1 << kScriptSwitch;
+	if(gameData.length() > 1 && gameData[1] == 'R') layout |= 1 << kScriptScale;
+	return layout;
+}
+
+int AutoScript::BuildProfile(Profile *profile, int layout) const
+{
+	const ScriptOp *ops[kMaxOps];
+	int count = Resolve(layout,ops,kMaxOps);
+	for(int i = 0; i < count; i++)
+	{
+		const ScriptOp &op = *ops[i];
+		Profile::DirectionType direction = op.Args[0] < 0 ? Profile::kProfileReverse : Profile::kProfileForward;
+		switch(op.Code)
+		{
+			case kScriptSpeed:
+				profile->ProfileMinSpeed = op.Args[0];
+				profile->ProfileMaxSpeed = op.Args[1];
+				break;
+			case kScriptMove:
+				profile->AddMove(direction,fabs(op.Args[0]));
+				break;
+			case kScriptCurve:
+				profile->AddCurve(direction,fabs(op.Args[0]),op.Args[1]);
+				break;
+			case kScriptTurn:
+				profile->AddTurn(op.Args[0],op.Args[1]);
+				break;
+			case kScriptPause:
+				profile->AddPause(op.Args[0]);
+				break;
+		}
+	}
+	return profile->GetStepCount();
+}
+
+int AutoScript::GetActions(int layout, const ScriptOp **actions, int maxActions) const
+{
+	const ScriptOp *ops[kMaxOps];
+	int count = Resolve(layout,ops,kMaxOps);
+	int actionCount = 0;
+	for(int i = 0; i < count; i++)
+		if(!IsDriveOp(*ops[i]) && actionCount < maxActions) actions[actionCount++] = ops[i];
+	return actionCount;
+}
+
+int AutoScript::LoadFile(const char *path)
+{
+	FILE *file = fopen(path,"rb");
+	if(file == NULL)
+	{
+		snprintf(Error,sizeof(Error),"%s not found",path);
+		ErrorLine = 0;
+		OpCount = 0;
+		return -1;
+	}
+	char text[kMaxText];
+	int length = fread(text,1,sizeof(text),file);
+	fclose(file);
+	ScriptHeader header;
+	uint32_t magic = kMagic;
+	if(length >= int(sizeof(header)) && memcmp(text,&magic,sizeof(magic)) == 0)
+	{
+		memcpy(&header,text,sizeof(header));
+		if(header.Version != kVersion || header.OpCount > kMaxOps ||
+				length != int(sizeof(header) + header.OpCount * sizeof(ScriptOp)))
+			return Fail(0,"binary script from another version");
+		OpCount = header.OpCount;
+		memcpy(Ops,text + sizeof(header),OpCount * sizeof(ScriptOp));
+		//the file may be cut short or from a build with other commands
+		for(int i = 0; i < OpCount; i++)
+		{
+			const char *message = CheckOp(Ops[i]);
+			if(message != NULL) return Fail(Ops[i].Line,message);
+		}
+		return Check();
+	}
+	if(length == kMaxText) return Fail(0,"script too long");
+	return Parse(text,length);
+}
+
+int AutoScript::Save(const char *path) const
+{
+	FILE *file = fopen(path,"wb");
+	if(file == NULL) return -1;
+	ScriptHeader header = {kMagic,kVersion,uint16_t(OpCount)};
+	fwrite(&header,sizeof(header),1,file);
+	fwrite(Ops,sizeof(ScriptOp),OpCount,file);
+	return fclose(file) == 0 ? OpCount : -1;
+}
+
+static uint32_t HashBytes(uint32_t hash, const void *data, int size)
+{
+	const uint8_t *bytes = (const uint8_t *)data;
+	for(int i = 0; i < size; i++) hash = (hash ^ bytes[i]) * 16777619u;
+	return hash;
+}
+
+uint32_t AutoScript::GetHash() const
+{
+	//field by field, the padding of a ScriptOp is not part of the script
+	uint32_t hash = 2166136261u;
+	for(int i = 0; i < OpCount; i++)
+	{
+		const ScriptOp &op = Ops[i];
+		hash = HashBytes(hash,&op.Code,sizeof(op.Code));
+		hash = HashBytes(hash,&op.Plate,sizeof(op.Plate));
+		hash = HashBytes(hash,&op.Side,sizeof(op.Side));
+		hash = HashBytes(hash,&op.ArgCount,sizeof(op.ArgCount));
+		hash = HashBytes(hash,op.Args,sizeof(op.Args));
+	}
+	return hash;
+}
+
+int64_t AutoScript::GetModifiedTime(const char *path)
+{
+	struct stat info;
+	if(stat(path,&info) != 0) return 0;
+	return int64_t(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+}
@@ -0,0 +1,116 @@
+/*
+ * AutoScript.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Autonomous routines read from a file instead of compiled into
+ *  Autonomous.cpp, run on thumbwheel 7.  One command per line, # comments:
+ *
+ *     SPEED 0.35 0.75        min and max speed of the moves after it
+ *     MOVE 8                 feet, negative backs up
+ *     CURVE 6 0.3            feet and curve (Robot::Auto_Drive)
+ *     TURN 90 0.5            heading and speed, negative speed turns left
+ *     PAUSE 500              ms
+ *     ARM 4                  lower the arm to a height
+ *     LIFT 6                 raise the lift to the top and lower the arm
+ *     EJECT 2 0.35           run the gripper out for seconds at a speed
+ *     IF SWITCH L            the lines up to ELSE or END run if our switch plate is on
+ *     ELSE                   that side (IF SCALE R for the scale), IFs nest 4 deep
+ *     END
+ *
+ *  The drive commands in a branch become steps of a Profile (BuildProfile),
+ *  the mechanism commands run after the drive in the order written, so in
+ *  every branch the drive commands have to come first.
+ *
+ *  Parse works in place on the text and allocates nothing, so a script loads
+ *  in microseconds.  Save writes the parsed commands as a binary file that
+ *  LoadFile reads back without parsing (same byte order, the roboRIO and a
+ *  PC are both little endian).
+ *
+ */
+
+#ifndef SRC_AUTOSCRIPT_H_
+#define SRC_AUTOSCRIPT_H_
+
+#include <stdint.h>
+#include <string>
+
+class Profile;
+
+typedef enum
+{
+	kScriptSpeed,
+	kScriptMove,
+	kScriptCurve,
+	kScriptTurn,
+	kScriptPause,
+	kScriptArm,
+	kScriptLift,
+	kScriptEject,
+	kScriptIf,
+	kScriptElse,
+	kScriptEnd
+} ScriptOpcode;
+
+//plate an IF looks at
+typedef enum {kScriptSwitch,kScriptScale} ScriptPlate;
+
+struct ScriptOp
+{
+	uint8_t Code = kScriptEnd;
+	uint8_t Plate = kScriptSwitch;	//IF
+	char Side = 'L';				//IF
+	uint8_t ArgCount = 0;
+	uint16_t Line = 0;
+	double Args[2] = {0.0,0.0};
+};
+
+class AutoScript
+{
+public:
+	static const int kMaxOps = 128;
+	static const int kMaxDepth = 4;
+	static const int kMaxText = 16384;
+	static const uint32_t kMagic = 0x53545541;	//"AUTS"
+	static const uint16_t kVersion = 1;
+	//game data layouts that give different branches, the first two letters LL, RL, LR, RR
+	static const int kLayouts = 4;
+private:
+	ScriptOp Ops[kMaxOps];
+	int OpCount = 0;
+	char Error[96];
+	int ErrorLine = 0;
+
+	int Fail(int line, const char *message);
+	//the ops a layout runs, IF/ELSE/END resolved, returns how many
+	int Resolve(int layout, const ScriptOp **ops, int maxOps) const;
+	//check the branch structure and that no drive follows a mechanism command
+	int Check();
+public:
+	AutoScript();
+
+	//parse text into commands, returns the number of commands or -1 (GetError says why)
+	int Parse(const char *text, int length);
+	//read a text or binary script, returns the number of commands or -1
+	int LoadFile(const char *path);
+	//write the commands as a binary script, returns -1 if the file can't be written
+	int Save(const char *path) const;
+	const char *GetError() const { return Error; }
+	//line of the error, 0 if it is the file itself
+	int GetErrorLine() const { return ErrorLine; }
+	int GetOpCount() const { return OpCount; }
+	const ScriptOp &GetOp(int index) const { return Ops[index]; }
+	//FNV-1a of the commands, the same for a script's text and binary forms
+	uint32_t GetHash() const;
+
+	//layout index for the game data
+	static int GetLayout(const std::string &gameData);
+	//add the drive commands of a layout to an empty profile, returns the number of steps
+	int BuildProfile(Profile *profile, int layout) const;
+	//the mechanism commands of a layout in order, returns how many
+	int GetActions(int layout, const ScriptOp **actions, int maxActions) const;
+	//modification time of a file, 0 if it can't be read
+	static int64_t GetModifiedTime(const char *path);
+};
+
+#endif /* SRC_AUTOSCRIPT_H_ */
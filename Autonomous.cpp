@@ -5,12 +5,93 @@
  *      Author: a851729
  */
 
-#include "robot.h"
+#include "Robot.h"
+#include "AutoCommands.h"
 
-void Robot::ExecuteProfile()
+//the plans' moves at the limits BuildPlans gives them with the default gains, built by the
+//compiler (MOVE steps store the speed as a float, so the limit is rounded the same way)
+static constexpr MotionLimits kAutoMoveLimits =
+	{0.0,0.0,float(Robot::kAutoMaxSpeed) * Profile::kDefaultMaxVelocity,float(Profile::kDefaultMaxAccel),0.0};
+#define AUTO_MOVE(distance) TRAJECTORY_TABLE(distance,kAutoMoveLimits,Profile::kDefaultTrajectoryDt)
+static constexpr auto kMove2 = AUTO_MOVE(2.0);
+static constexpr auto kMove2_5 = AUTO_MOVE(2.5);
+static constexpr auto kMove2_8 = AUTO_MOVE(2.8);
+static constexpr auto kMove5_5 = AUTO_MOVE(5.5);
+static constexpr auto kMove6_3 = AUTO_MOVE(6.3);
+static constexpr auto kMove8 = AUTO_MOVE(8.0);
+static constexpr auto kMove13 = AUTO_MOVE(13.0);
+static constexpr auto kMove18 = AUTO_MOVE(18.0);
+static constexpr auto kMove41_3 = AUTO_MOVE(41.3);
+static constexpr auto kMove44 = AUTO_MOVE(44.0);
+
+//a table sampled at the profile's dt, cruising at the limit and ending stopped on the target
+template<int N>
+constexpr bool CheckAutoMove(const TrajectoryTable<N> &table, double distance)
+{
+	if(table.Count != N || table.Dt != Profile::kDefaultTrajectoryDt) return false;
+	if(table.Samples[N-1].Position != distance || table.Samples[N-1].Velocity != 0.0) return false;
+	for(int i = 1; i < N; i++)
+	{
+		if(table.Samples[i].Position < table.Samples[i-1].Position) return false;
+		if(table.Samples[i].Velocity > table.Limits.MaxVelocity) return false;
+	}
+	return true;
+}
+static_assert(CheckAutoMove(kMove2,2.0),"kMove2");
+static_assert(CheckAutoMove(kMove2_5,2.5),"kMove2_5");
+static_assert(CheckAutoMove(kMove2_8,2.8),"kMove2_8");
+static_assert(CheckAutoMove(kMove5_5,5.5),"kMove5_5");
+static_assert(CheckAutoMove(kMove6_3,6.3),"kMove6_3");
+static_assert(CheckAutoMove(kMove8,8.0),"kMove8");
+static_assert(CheckAutoMove(kMove13,13.0),"kMove13");
+static_assert(CheckAutoMove(kMove18,18.0),"kMove18");
+static_assert(CheckAutoMove(kMove41_3,41.3),"kMove41_3");
+static_assert(CheckAutoMove(kMove44,44.0),"kMove44");
+
+bool Robot::ProfileRunning()
 {
+	if(Streaming) return AutoProfile->ProfileLoaded && !Stream->IsFinished();
+	if(Drive != NULL) return AutoProfile->ProfileLoaded && !Drive->IsCompleted();
+	return AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted;
+}
 
-	AutoProfile->ExecuteProfile(GetHeading(),fabs(GetDistance()));
+void Robot::ExecuteProfile()
+{
+	if(Stream != NULL && !StreamChecked)
+	{
+		//wait for the fill thread to let go of the last stream's points
+		if(!Stream->IsStopped()) return;
+		//straight line profiles run on the Talons, the rest need the heading loop here
+		StreamChecked = true;
+		if(Stream->Load(*AutoProfile) > 0)
+		{
+			Stream->Start(Sensors.LeftEncoder,Sensors.RightEncoder);
+			Streaming = true;
+		}
+	}
+	if(Streaming)
+	{
+		TelemetryRecord *rec = Recorder->Current();
+		rec->Heading = GetHeading();
+		rec->Distance = fabs(GetDistance());
+		return;
+	}
+	if(Drive != NULL)
+	{
+		//the drive loop runs the profile, this cycle only starts it and records where it is
+		if(!Drive->IsActive()) Drive->Start(AutoProfile,GetPose(),HeadingOffset);
+		const DriveStatus &status = Drive->GetStatus();
+		TelemetryRecord *rec = Recorder->Current();
+		rec->Heading = status.Heading;
+		rec->Distance = status.Distance;
+		return;
+	}
+	double heading = GetHeading();
+	double distance = fabs(GetDistance());
+	TelemetryRecord *rec = Recorder->Current();
+	rec->Heading = heading;
+	rec->Distance = distance;
+	AutoProfile->ExecuteProfile(heading,distance,GetPose());
 	Auto_Drive(AutoProfile->OutputMagnitude,AutoProfile->Curve);
 }
 
@@ -39,31 +120,10 @@ void Robot::ExecuteProfile()
 
 void Robot::Auto_Drive(double outputMagnitude, double curve)
 {
-	double m_sensitivity = 0.75;
 	double leftOutput, rightOutput;
-	if (curve < 0)
-	{
-		double value = std::log(-curve);
-		double ratio = (value - m_sensitivity) / (value + m_sensitivity);
-		if (ratio == 0) ratio = .0000000001;
-		leftOutput = outputMagnitude / ratio;
-		rightOutput = outputMagnitude;
-	}
-	else if (curve > 0)
-	{
-		double value = std::log(curve);
-		double ratio = (value - m_sensitivity) / (value + m_sensitivity);
-		if (ratio == 0) ratio = .0000000001;
-		leftOutput = outputMagnitude;
-		rightOutput = outputMagnitude / ratio;
-	}
-	else
-	{
-		leftOutput = outputMagnitude;
-		rightOutput = outputMagnitude;
-	}
-	MotorLF->Set(Clamp(leftOutput,-1.0,1.0));
-	MotorRF->Set(-Clamp(rightOutput,-1.0,1.0));
+	DriveLoop::CurveToWheels(outputMagnitude,curve,&leftOutput,&rightOutput);
+	DriveLoop::Desaturate(&leftOutput,&rightOutput);
+	IO->SetDrive(leftOutput,-rightOutput);
 }
 
 double Robot::Clamp(double value, double min, double max)
@@ -73,471 +133,281 @@ double Robot::Clamp(double value, double min, double max)
 	return value;
 }
 
-void Robot::Auto_Straight()
+//which variant of a thumbwheel routine the game data calls for, 0 drives straight
+//0 or 1-2 for the left or right switch plate from the center, 1 switch or 2 scale from the sides
+int Robot::GetAutoChoice(int thumbWheel, const std::string &gameData)
 {
-	switch(AutoState)  //autonomous sequencer
+	if(gameData.length() < 2) return 0;
+	switch(thumbWheel)
 	{
-		case 0:
-			AutoProfile->Initialize();
-			AutoProfile->ClearProfile();
-			AutoProfile->AddMove(AutoProfile->kProfileForward,8);
-			AutoProfile->ProfileLoaded = true;
-			AutoState++;
-			break;
-		case 1:
-			if(AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted) ExecuteProfile();
-			else
-			{
-				AutoState++;
-				printf("Auto_Straight Completed\n");
-			}
-			break;
+		case 2:
+			return gameData[0] == 'L' ? 1 : 2;
+		case 3:  //switch first
+		case 4:
+		{
+			char side = thumbWheel == 3 ? 'L' : 'R';
+			if(gameData[0] == side) return 1;
+			if(gameData[1] == side) return 2;
+			return 0;
+		}
+		case 5:  //scale first
+		case 6:
+		{
+			char side = thumbWheel == 5 ? 'L' : 'R';
+			if(gameData[1] == side) return 2;
+			if(gameData[0] == side) return 1;
+			return 0;
+		}
 		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
-			break;
+			return 0;
 	}
 }
 
-void Robot::Auto_SwitchFrom2()   //left wheels on center line
+//the steps of one routine and choice, built ahead of autonomous by BuildPlans
+void Robot::BuildPlan(Profile *plan, int thumbWheel, int choice)
 {
-	switch(AutoState)  //autonomous sequencer
+	switch(thumbWheel)
 	{
-		case 0:
-			AutoProfile->Initialize();
-			AutoProfile->ClearProfile();
-			AutoProfile->AddMove(AutoProfile->kProfileForward,2.5);
-			if(GameData[0] == 'L') //deliver to left switch plate
-			{
-				AutoProfile->AddTurn(315,-TurnMaxSpeed);
-				AutoProfile->AddMove(AutoProfile->kProfileForward,6.3);
-				AutoProfile->AddTurn(0,TurnMaxSpeed);
-			}
-			else  //deliver to right switch plate
-			{
-				AutoProfile->AddTurn(35,TurnMaxSpeed);
-				AutoProfile->AddMove(AutoProfile->kProfileForward,5.5);
-				AutoProfile->AddTurn(0,-TurnMaxSpeed);
-			}
-			AutoProfile->ProfileLoaded = true;
-			AutoState++;
-			break;
 		case 1:
-			if(AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted) ExecuteProfile();
-			else AutoState++;
+			plan->AddMove(plan->kProfileForward,kMove8);
 			break;
-		case 2:  //lower arm
-			if(ArmLowered(4.0))
+		case 2:  //left wheels on center line
+			plan->AddMove(plan->kProfileForward,kMove2_5);
+			if(choice == 1) //deliver to left switch plate
 			{
-				AutoState++;
-				AutoTimer->Reset();
+				plan->AddTurn(315,-TurnMaxSpeed);
+				plan->AddMove(plan->kProfileForward,kMove6_3);
+				plan->AddTurn(0,TurnMaxSpeed);
 			}
-			break;
-		case 3:  //spit out crate
-			if(EjectCrate(2.0,0.35))
+			else  //deliver to right switch plate
 			{
-				AutoState++;
-				printf("SwitchFrom2 Completed\n");
+				plan->AddTurn(35,TurnMaxSpeed);
+				plan->AddMove(plan->kProfileForward,kMove5_5);
+				plan->AddTurn(0,-TurnMaxSpeed);
 			}
 			break;
-		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
-			break;
-	}
-}
-
-void Robot::Auto_SwitchOrScaleFrom1()    //start right wheels 9.5 ft left of center line
-{
-	static int choice = 0;
-	double spd = 0.35;
-	switch(AutoState)  //autonomous sequencer
-	{
-		case 0:
-			AutoProfile->Initialize();
-			AutoProfile->ClearProfile();
-			//deliver to left switch plate
-			if(GameData[0] == 'L') choice = 1;
-			//deliver to left scale
-			if(choice != 1 && GameData[1] == 'L') choice = 2;
+		case 3:  //start right wheels 9.5 ft left of center line
 			switch(choice)
 			{
 				case 0:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,8);
+					plan->AddMove(plan->kProfileForward,kMove8);
 					break;
 				case 1:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,13);
-					AutoProfile->AddTurn(90,TurnMaxSpeed);
-					AutoProfile->AddMove(AutoProfile->kProfileForward,2);
-					printf("SWITCH Chosen\n");
-					break;
-				case 2:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,44);
-					AutoProfile->AddTurn(90,TurnMaxSpeed);
-					//AutoProfile->AddMove(AutoProfile->kProfileForward,2);
-					printf("SCALE Chosen\n");
-					break;
-			}
-			AutoProfile->ProfileLoaded = true;
-			AutoState++;
-			break;
-		case 1:  //move to target
-			if(AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted) ExecuteProfile();
-			else
-			{
-				AutoState++;
-				AutoTimer->Reset();
-			}
-			break;
-		case 2:  //raise lift if at scale - lower arm if at switch
-			switch(choice)
-			{
-				case 1:
-					if(ArmLowered(4.0))
+					if(AutoUseSplines)
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						const Waypoint path[] = {{0,0,0},{9,0,0},{13.8,3,90}};
+						plan->AddSpline(path,3);
 					}
-					break;
-				case 2:
-					if(LiftRaisedToUpperLimitAndArmLowered(6.0))
+					else
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						plan->AddMove(plan->kProfileForward,kMove13);
+						plan->AddTurn(90,TurnMaxSpeed);
+						plan->AddMove(plan->kProfileForward,kMove2);
 					}
 					break;
-				default:
-					AutoState++;
-					AutoTimer->Reset();
+				case 2:
+					plan->AddMove(plan->kProfileForward,kMove44);
+					plan->AddTurn(90,TurnMaxSpeed);
+					//plan->AddMove(plan->kProfileForward,2);
 					break;
 			}
 			break;
-		case 3:  //spit out crate
-			if(choice > 1) spd = 1.0;
-			if(EjectCrate(2.0,spd))
-			{
-				AutoState++;
-				printf("SwitchOrScaleFrom1 Completed\n");
-			}
-			break;
-		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
-			break;
-	}
-}
-
-void Robot::Auto_SwitchOrScaleFrom3()    //start left wheels 9.5 ft right of center line
-{
-	static int choice = 0;
-	double spd = 0.35;
-	switch(AutoState)  //autonomous sequencer
-	{
-		case 0:
-			AutoProfile->Initialize();
-			AutoProfile->ClearProfile();
-			//deliver to switch
-			if(GameData[0] == 'R') choice = 1;
-			//deliver to scale
-			if(choice != 1 && GameData[1] == 'R') choice = 2;
+		case 4:  //start left wheels 9.5 ft right of center line
 			switch(choice)
 			{
 				case 0:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,8);
+					plan->AddMove(plan->kProfileForward,kMove8);
 					break;
 				case 1:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,13);
-					AutoProfile->AddTurn(270,-TurnMaxSpeed);
-					AutoProfile->AddMove(AutoProfile->kProfileForward,2);
-					printf("SWITCH Chosen\n");
-					break;
-				case 2:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,44);
-					AutoProfile->AddTurn(270,-TurnMaxSpeed);
-					//AutoProfile->AddMove(AutoProfile->kProfileForward,2);
-					printf("SCALE Chosen\n");
-					break;
-			}
-			AutoProfile->ProfileLoaded = true;
-			AutoState++;
-			break;
-		case 1:  //move to target
-			if(AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted) ExecuteProfile();
-			else
-			{
-				AutoState++;
-				AutoTimer->Reset();
-			}
-			break;
-		case 2:  //raise lift if at scale - lower arm if at switch
-			switch(choice)
-			{
-				case 1:
-					if(ArmLowered(3.0))
+					if(AutoUseSplines)
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						const Waypoint path[] = {{0,0,0},{9,0,0},{13.8,-3,-90}};
+						plan->AddSpline(path,3);
 					}
-					break;
-				case 2:
-					if(LiftRaisedToUpperLimitAndArmLowered(6.0))
+					else
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						plan->AddMove(plan->kProfileForward,kMove13);
+						plan->AddTurn(270,-TurnMaxSpeed);
+						plan->AddMove(plan->kProfileForward,kMove2);
 					}
 					break;
-				default:
-					AutoState++;
-					AutoTimer->Reset();
+				case 2:
+					plan->AddMove(plan->kProfileForward,kMove44);
+					plan->AddTurn(270,-TurnMaxSpeed);
+					//plan->AddMove(plan->kProfileForward,2);
 					break;
 			}
 			break;
-		case 3:  //spit out crate
-			if(choice > 1) spd = 1.0;
-			if(EjectCrate(2.0,spd))
-			{
-				AutoState++;
-				printf("SwitchOrScaleFrom3 Completed\n");
-			}
-			break;
-		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
-			break;
-	}
-}
-
-void Robot::Auto_ScaleOrSwitchFrom1()    //start right wheels 9.5 ft left of center line
-{
-	static int choice = 0;
-	double spd = 0.35;
-	switch(AutoState)  //autonomous sequencer
-	{
-		case 0:
-			AutoProfile->Initialize();
-			AutoProfile->ClearProfile();
-			//deliver to scale
-			if(GameData[1] == 'L') choice = 2;
-			//deliver to switch
-			if(choice != 2 && GameData[0] == 'L') choice = 1;
+		case 5:  //start right wheels 9.5 ft left of center line
 			switch(choice)
 			{
 				case 0:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,8);
-					break;
-				case 1:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,18);
-					AutoProfile->AddTurn(90,TurnMaxSpeed);
-					AutoProfile->AddMove(AutoProfile->kProfileForward,2.8);
-					printf("SWITCH Chosen\n");
+					plan->AddMove(plan->kProfileForward,kMove8);
 					break;
-				case 2:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,41.3);
-					AutoProfile->AddTurn(90,TurnMaxSpeed);
-					//AutoProfile->AddMove(AutoProfile->kProfileForward,2);
-					printf("SCALE Chosen\n");
-					break;
-			}
-			AutoProfile->ProfileLoaded = true;
-			AutoState++;
-			break;
-		case 1:  //move to target
-			if(AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted) ExecuteProfile();
-			else
-			{
-				AutoState++;
-				AutoTimer->Reset();
-			}
-			break;
-		case 2:  //raise lift if at scale - lower arm if at switch
-			switch(choice)
-			{
 				case 1:
-					if(ArmLowered(4.0))
+					if(AutoUseSplines)
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						const Waypoint path[] = {{0,0,0},{14,0,0},{18.5,3.8,90}};
+						plan->AddSpline(path,3);
 					}
-					break;
-				case 2:
-					if(LiftRaisedToUpperLimitAndArmLowered(6.0))
+					else
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						plan->AddMove(plan->kProfileForward,kMove18);
+						plan->AddTurn(90,TurnMaxSpeed);
+						plan->AddMove(plan->kProfileForward,kMove2_8);
 					}
 					break;
-				default:
-					AutoState++;
-					AutoTimer->Reset();
+				case 2:
+					plan->AddMove(plan->kProfileForward,kMove41_3);
+					plan->AddTurn(90,TurnMaxSpeed);
+					//plan->AddMove(plan->kProfileForward,2);
 					break;
 			}
 			break;
-		case 3:  //spit out crate
-			if(choice > 1) spd = 1.0;
-			if(EjectCrate(2.0,spd))
-			{
-				AutoState++;
-				printf("ScaleOrSwitchFrom1 Completed\n");
-			}
-			break;
-		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
-			break;
-	}
-}
-
-void Robot::Auto_ScaleOrSwitchFrom3()    //start left wheels 9.5 ft right of center line
-{
-	static int choice = 0;
-	double spd = 0.35;
-	switch(AutoState)  //autonomous sequencer
-	{
-		case 0:
-			AutoProfile->Initialize();
-			AutoProfile->ClearProfile();
-			//deliver to scale
-			if(GameData[1] == 'R') choice = 2;
-			//deliver to switch
-			if(choice != 2 && GameData[0] == 'R') choice = 1;
+		case 6:  //start left wheels 9.5 ft right of center line
 			switch(choice)
 			{
 				case 0:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,8);
+					plan->AddMove(plan->kProfileForward,kMove8);
 					break;
 				case 1:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,18);
-					AutoProfile->AddTurn(270,-TurnMaxSpeed);
-					AutoProfile->AddMove(AutoProfile->kProfileForward,2.8);
-					printf("SWITCH Chosen\n");
-					break;
-				case 2:
-					AutoProfile->AddMove(AutoProfile->kProfileForward,41.3);
-					AutoProfile->AddTurn(270,-TurnMaxSpeed);
-					//AutoProfile->AddMove(AutoProfile->kProfileForward,2);
-					printf("SCALE Chosen\n");
-					break;
-			}
-			AutoProfile->ProfileLoaded = true;
-			AutoState++;
-			break;
-		case 1:  //move to target
-			if(AutoProfile->ProfileLoaded && !AutoProfile->ProfileCompleted) ExecuteProfile();
-			else
-			{
-				AutoState++;
-				AutoTimer->Reset();
-			}
-			break;
-		case 2:  //raise lift if at scale - lower arm if at switch
-			switch(choice)
-			{
-				case 1:
-					if(ArmLowered(4.0))
+					if(AutoUseSplines)
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						const Waypoint path[] = {{0,0,0},{14,0,0},{18.5,-3.8,-90}};
+						plan->AddSpline(path,3);
 					}
-					break;
-				case 2:
-					if(LiftRaisedToUpperLimitAndArmLowered(6.0))
+					else
 					{
-						AutoState++;
-						AutoTimer->Reset();
+						plan->AddMove(plan->kProfileForward,kMove18);
+						plan->AddTurn(270,-TurnMaxSpeed);
+						plan->AddMove(plan->kProfileForward,kMove2_8);
 					}
 					break;
-				default:
-					AutoState++;
-					AutoTimer->Reset();
+				case 2:
+					plan->AddMove(plan->kProfileForward,kMove41_3);
+					plan->AddTurn(270,-TurnMaxSpeed);
+					//plan->AddMove(plan->kProfileForward,2);
 					break;
 			}
 			break;
-		case 3:  //spit out crate
-			if(choice > 1) spd = 1.0;
-			if(EjectCrate(2.0,spd))
-			{
-				AutoState++;
-				printf("ScaleOrSwitchFrom3 Completed\n");
-			}
-			break;
-		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
-			break;
 	}
 }
 
+//the thumbwheel routines for each choice, from the commands in AutoCommands.h
+void Robot::BuildRoutines()
+{
+	Command *drive = new DriveProfileCommand(this,IO);
+	Command *ejectSlow = new EjectCommand(this,IO,AutoTimer,2.0,0.35);
+	//cross the line, then spit out the crate where it is
+	Command *line = new SequentialGroup({drive,ejectSlow});
+	//lower the arm over the switch plate and spit out the crate
+	Command *switchArm4 = new SequentialGroup({drive,new ArmLoweredCommand(this,IO,4.0),ejectSlow});
+	Command *switchArm3 = new SequentialGroup({drive,new ArmLoweredCommand(this,IO,3.0),ejectSlow});
+	//raise the lift and lower the arm over the end of the drive, then throw the crate onto the scale
+	Command *liftNearScale = new SequentialGroup({new WaitDistanceCommand(this,AutoLiftDistance),
+			new LiftAndArmCommand(this,IO,6.0)});
+	Command *scale = new SequentialGroup({new ParallelGroup({drive,liftNearScale}),
+			new EjectCommand(this,IO,AutoTimer,2.0,1.0)});
+
+	for(int c = 0; c < kAutoChoices; c++)
+	{
+		//1: drive straight to cross line
+		AutoRoutines[0][c] = drive;
+		//2: place switch left or right
+		AutoRoutines[1][c] = switchArm4;
+	}
+	//3 and 5 from the left, 4 and 6 from the right, the switch or scale on our side else cross line
+	Command *sides[4][kAutoChoices] =
+	{
+		{line,switchArm4,scale},
+		{line,switchArm3,scale},
+		{line,switchArm4,scale},
+		{line,switchArm4,scale}
+	};
+	for(int r = 0; r < 4; r++)
+		for(int c = 0; c < kAutoChoices; c++) AutoRoutines[r + 2][c] = sides[r][c];
+	//7: the script's plan and mechanism commands, loaded at AutonomousInit
+	ScriptRoutine = new ScriptCommand(this,IO,AutoTimer,drive);
+}
+
+//runs the routine scheduled at AutonomousInit
+void Robot::Auto_Routine()
+{
+	if(AutoComplete)
+	{
+		IO->SetDrive(0.0,0.0);
+		IO->SetArm(0.0);
+		IO->SetLift(0.0);
+		IO->SetGrip(0.0);
+		return;
+	}
+	Scheduler->Run();
+	if(!Scheduler->IsScheduled(AutoRoutine)) SetAutoComplete();
+}
+
 bool Robot::EjectCrate(double seconds, double speed)
 {
 	if(!AutoTimer->HasPeriodPassed(seconds))
 	{
-		MotorGrip->Set(fabs(speed));
+		IO->SetGrip(fabs(speed));
 		return false;
 	}
 	else
 	{
-		MotorGrip->Set(0.0);
+		IO->SetGrip(0.0);
 		return true;
 	}
 }
 
 bool Robot::LiftRaisedToUpperLimit()
 {
-	if(LimitLiftHi->Get())
+	if(Sensors.LimitLiftHi)
 	{
-		MotorLift->Set(GetLiftSpeed(-0.75,!LimitLiftLo->Get(),!LimitLiftHi->Get()));
+		IO->SetLift(GetLiftSpeed(-0.75,!Sensors.LimitLiftLo,!Sensors.LimitLiftHi));
 		return false;
 	}
 	else
 	{
-		MotorLift->Set(0.0);
+		IO->SetLift(0.0);
 		return true;
 	}
 }
 
 bool Robot::ArmLowered(double height)
 {
-	double posArm = PotArm->Get();
+	double posArm = Sensors.ArmPosition;
 	if(posArm > height)
 	{
-		MotorArm->Set(GetArmSpeed(-0.5,posArm,7.5,1.5,1.0,0.0));
+		IO->SetArm(GetArmSpeed(-0.5,posArm,7.5,1.5,1.0,0.0));
 		return false;
 	}
 	else
 	{
-		MotorArm->Set(0.0);
+		IO->SetArm(0.0);
 		return true;
 	}
 }
 
 bool Robot::LiftRaisedToUpperLimitAndArmLowered(double height)
 {
-	double posArm = PotArm->Get();
+	double posArm = Sensors.ArmPosition;
 
-	if(LimitLiftHi->Get())
-		MotorLift->Set(GetLiftSpeed(-0.75,!LimitLiftLo->Get(),!LimitLiftHi->Get()));
+	if(Sensors.LimitLiftHi)
+		IO->SetLift(GetLiftSpeed(-0.75,!Sensors.LimitLiftLo,!Sensors.LimitLiftHi));
 	else
-		MotorLift->Set(0.0);
+		IO->SetLift(0.0);
 
 	if(posArm > height)
-		MotorArm->Set(GetArmSpeed(-0.5,posArm,7.5,1.5,1.0,0.0));
+		IO->SetArm(GetArmSpeed(-0.5,posArm,7.5,1.5,1.0,0.0));
 	else
-		MotorArm->Set(0.0);
+		IO->SetArm(0.0);
 
-	if(!LimitLiftHi->Get() && posArm < height) return true;
+	if(!Sensors.LimitLiftHi && posArm < height) return true;
 	else return false;
 }
 
-
+void Robot::SetAutoComplete()
+{
+	AutoComplete = true;
+	Logger::Write(kLogAutoCompleted,ThumbWheel);
+}
@@ -0,0 +1,127 @@
+/*
+ * CanScheduler.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CanScheduler.h"
+#include "Logger.h"
+#include "MotionStreamer.h"
+
+const int CanScheduler::kDefaultPeriods[kCanStatusCount] = {10,20,160,160,160,160,160,160,160};
+
+SimCanDevice::SimCanDevice(int deviceID) : DeviceID(deviceID)
+{
+	for(int i = 0; i < kCanStatusCount; i++) Periods[i] = CanScheduler::kDefaultPeriods[i];
+}
+
+bool SimCanDevice::SetStatusFramePeriod(CanStatusFrame frame, int periodMs)
+{
+	if(periodMs < 1 || periodMs > CanScheduler::kSlowestPeriodMs) return false;
+	Periods[frame] = periodMs;
+	return true;
+}
+
+CanScheduler::CanScheduler(double driveLoopRate, bool streaming) : Streaming(streaming), Calls(0)
+{
+	//one frame per read of the encoders, the 50Hz loop reads every 20ms
+	double rate = driveLoopRate > 50 ? driveLoopRate : 50;
+	FeedbackPeriod = int(1000.0 / rate);
+	if(FeedbackPeriod < 1) FeedbackPeriod = 1;
+}
+
+int CanScheduler::AddDevice(CanDevice *device, CanRole role)
+{
+	if(DeviceCount >= kMaxDevices) return -1;
+	Entry &entry = Devices[DeviceCount];
+	entry.Device = device;
+	entry.Role = role;
+	for(int i = 0; i < kCanStatusCount; i++) entry.Periods[i] = kDefaultPeriods[i];
+	return DeviceCount++;
+}
+
+int CanScheduler::GetRolePeriod(CanRole role, CanStatusFrame frame) const
+{
+	switch(role)
+	{
+		case kCanDriveMaster:
+			switch(frame)
+			{
+				case kCanStatusGeneral: return kDefaultPeriods[kCanStatusGeneral];
+				case kCanStatusFeedback: return FeedbackPeriod;
+				//the fill checks the buffer every pass, the active point is only for debugging
+				case kCanStatusProfileBuffer: return Streaming ? MotionStreamer::kPointMs / 2 : kSlowestPeriodMs;
+				case kCanStatusTargets: return Streaming ? MotionStreamer::kPointMs : kSlowestPeriodMs;
+				default: return kSlowestPeriodMs;
+			}
+		case kCanDriveFollower:
+			//faults still show on the driver station, nothing reads the rest
+			if(frame == kCanStatusGeneral) return 100;
+			return kSlowestPeriodMs;
+	}
+	return kDefaultPeriods[frame];
+}
+
+int CanScheduler::Configure()
+{
+	int refused = 0;
+	for(int d = 0; d < DeviceCount; d++)
+	{
+		Entry &entry = Devices[d];
+		for(int f = 0; f < kCanStatusCount; f++)
+		{
+			int period = GetRolePeriod(entry.Role,CanStatusFrame(f));
+			if(entry.Device->SetStatusFramePeriod(CanStatusFrame(f),period)) entry.Periods[f] = period;
+			else
+			{
+				Logger::Write(kLogCanFrameRefused,entry.Device->GetDeviceID(),f,period);
+				refused++;
+			}
+		}
+	}
+	return refused;
+}
+
+double CanScheduler::FramesPerSecond(const int *periods)
+{
+	double frames = 1000.0 / kControlPeriodMs;
+	for(int f = 0; f < kCanStatusCount; f++) frames += 1000.0 / periods[f];
+	return frames;
+}
+
+double CanScheduler::GetUtilization() const
+{
+	double frames = 0.0;
+	for(int d = 0; d < DeviceCount; d++) frames += FramesPerSecond(Devices[d].Periods);
+	return frames * kFrameBits / kBitRate;
+}
+
+double CanScheduler::GetDefaultUtilization() const
+{
+	return DeviceCount * FramesPerSecond(kDefaultPeriods) * kFrameBits / kBitRate;
+}
+
+int CanScheduler::GetHeadroomDevices() const
+{
+	double perDevice = FramesPerSecond(kDefaultPeriods) * kFrameBits / kBitRate;
+	double spare = kTargetUtilization - GetUtilization();
+	return spare > 0 ? int(spare / perDevice) : 0;
+}
+
+void CanScheduler::EndCycle()
+{
+	uint32_t calls = Calls.exchange(0,std::memory_order_relaxed);
+	CallTotal += calls;
+	if(calls > CallMax) CallMax = calls;
+	Cycles++;
+}
+
+void CanScheduler::Report()
+{
+	Logger::Write(kLogCanUtilization,GetUtilization() * 100,GetDefaultUtilization() * 100,DeviceCount,GetHeadroomDevices());
+	if(Cycles == 0) return;
+	Logger::Write(kLogCanCalls,double(CallTotal) / Cycles,CallMax,Cycles);
+	CallTotal = 0;
+	CallMax = 0;
+	Cycles = 0;
+}
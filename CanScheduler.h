@@ -0,0 +1,123 @@
+/*
+ * CanScheduler.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Status frame periods for the CAN devices, picked by the job each device
+ *  does instead of left at the Phoenix defaults.  A drive master sends its
+ *  selected sensor (Feedback) frame once per drive loop tick so the loop never
+ *  reads a stale encoder count, and the motion profile frames fast only while
+ *  streaming.  Followers and frames nobody reads drop to the slowest period.
+ *
+ *  From the periods it estimates the bus load (each frame counted at its
+ *  worst case length with bit stuffing) and how many more Talons at the
+ *  default periods would fit under kTargetUtilization.  It also counts the
+ *  device API calls the control code makes each 50Hz cycle.
+ *
+ *  Devices are reached through CanDevice, a TalonCanDevice (FRCRobotIO.h) on
+ *  the robot or a SimCanDevice for the tools.
+ *
+ */
+
+#ifndef SRC_CANSCHEDULER_H_
+#define SRC_CANSCHEDULER_H_
+
+#include <atomic>
+#include <stdint.h>
+
+typedef enum
+{
+	kCanStatusGeneral,			//output, faults
+	kCanStatusFeedback,			//selected sensor position and velocity
+	kCanStatusQuadrature,
+	kCanStatusAnalogTempVbat,
+	kCanStatusPulseWidth,
+	kCanStatusProfileBuffer,	//motion profile buffer counts and flags
+	kCanStatusTargets,			//motion profile active point
+	kCanStatusPIDF0,
+	kCanStatusPIDF1,
+	kCanStatusCount
+} CanStatusFrame;
+
+typedef enum {kCanDriveMaster,kCanDriveFollower} CanRole;
+
+class CanDevice
+{
+public:
+	virtual ~CanDevice() {}
+	virtual int GetDeviceID() = 0;
+	//false if the device did not take it
+	virtual bool SetStatusFramePeriod(CanStatusFrame frame, int periodMs) = 0;
+};
+
+//mock device that keeps the periods it was given
+class SimCanDevice : public CanDevice
+{
+private:
+	int DeviceID;
+	int Periods[kCanStatusCount];
+public:
+	SimCanDevice(int deviceID);
+	int GetDeviceID() { return DeviceID; }
+	bool SetStatusFramePeriod(CanStatusFrame frame, int periodMs);
+	int GetStatusFramePeriod(CanStatusFrame frame) const { return Periods[frame]; }
+};
+
+class CanScheduler
+{
+public:
+	static const int kMaxDevices = 16;
+	static const int kBitRate = 1000000;
+	static const int kFrameBits = 160;			//29 bit ID, 8 data bytes, worst case stuffing
+	static const int kControlPeriodMs = 10;		//control frame the RIO sends each device
+	static const int kSlowestPeriodMs = 255;
+	static constexpr double kTargetUtilization = 0.7;
+	static const int kDefaultPeriods[kCanStatusCount];	//Phoenix defaults, ms
+private:
+	struct Entry
+	{
+		CanDevice *Device;
+		CanRole Role;
+		int Periods[kCanStatusCount];
+	};
+	Entry Devices[kMaxDevices];
+	int DeviceCount = 0;
+	int FeedbackPeriod;
+	bool Streaming;
+	//calls per 50Hz cycle, counted from any thread
+	std::atomic<uint32_t> Calls;
+	uint64_t CallTotal = 0;
+	uint32_t CallMax = 0;
+	uint32_t Cycles = 0;
+
+	static double FramesPerSecond(const int *periods);
+public:
+	//driveLoopRate in Hz is how often the drive masters' feedback is read, 0 for the 50Hz loop
+	CanScheduler(double driveLoopRate, bool streaming);
+
+	//returns the device's index, -1 if the table is full
+	int AddDevice(CanDevice *device, CanRole role);
+	//period in ms of a frame for a role
+	int GetRolePeriod(CanRole role, CanStatusFrame frame) const;
+	//send every device its role's periods, returns the number of frames a device refused
+	int Configure();
+	int GetDeviceCount() const { return DeviceCount; }
+	int GetPeriod(int index, CanStatusFrame frame) const { return Devices[index].Periods[frame]; }
+	CanDevice *GetDevice(int index) const { return Devices[index].Device; }
+
+	//fraction of the bus used with the role periods
+	double GetUtilization() const;
+	//the same devices at the Phoenix defaults
+	double GetDefaultUtilization() const;
+	//Talons at the default periods that could be added before kTargetUtilization
+	int GetHeadroomDevices() const;
+
+	//count device API calls made by the control code
+	void CountCall(uint32_t calls = 1) { Calls.fetch_add(calls,std::memory_order_relaxed); }
+	//end of a 50Hz cycle, rolls the call count into the stats
+	void EndCycle();
+	//log the load, headroom and calls per cycle
+	void Report();
+};
+
+#endif /* SRC_CANSCHEDULER_H_ */
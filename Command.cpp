@@ -0,0 +1,184 @@
+/*
+ * Command.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Command.h"
+#include "Logger.h"
+
+CommandGroup::CommandGroup(std::initializer_list<Command *> commands)
+{
+	//a routine missing its last steps must not go unnoticed
+	if(commands.size() > size_t(kMaxCommands)) Logger::Write(kLogGroupFull,commands.size(),kMaxCommands);
+	for(Command *command : commands)
+	{
+		if(CommandCount == kMaxCommands) break;
+		Running[CommandCount] = false;
+		Commands[CommandCount++] = command;
+		Requirements |= command->GetRequirements();
+	}
+}
+
+void CommandGroup::EndRunning()
+{
+	for(int i = 0; i < CommandCount; i++)
+	{
+		if(!Running[i]) continue;
+		Running[i] = false;
+		Commands[i]->End(true);
+	}
+}
+
+void SequentialGroup::Initialize()
+{
+	Current = 0;
+	if(CommandCount == 0) return;
+	Running[0] = true;
+	Commands[0]->Initialize();
+}
+
+bool SequentialGroup::Execute()
+{
+	if(Current >= CommandCount) return true;
+	if(!Commands[Current]->Execute()) return false;
+	Running[Current] = false;
+	Commands[Current]->End(false);
+	if(++Current == CommandCount) return true;
+	Running[Current] = true;
+	Commands[Current]->Initialize();
+	return false;
+}
+
+void SequentialGroup::End(bool interrupted)
+{
+	if(interrupted) EndRunning();
+}
+
+void ParallelGroup::Initialize()
+{
+	for(int i = 0; i < CommandCount; i++)
+	{
+		Running[i] = true;
+		Commands[i]->Initialize();
+	}
+}
+
+bool ParallelGroup::Execute()
+{
+	bool running = false;
+	for(int i = 0; i < CommandCount; i++)
+	{
+		if(!Running[i]) continue;
+		if(Commands[i]->Execute())
+		{
+			Running[i] = false;
+			Commands[i]->End(false);
+		}
+		else running = true;
+	}
+	return !running;
+}
+
+void ParallelGroup::End(bool /*interrupted*/)
+{
+	EndRunning();
+}
+
+bool RaceGroup::Execute()
+{
+	for(int i = 0; i < CommandCount; i++)
+	{
+		if(!Running[i] || !Commands[i]->Execute()) continue;
+		Running[i] = false;
+		Commands[i]->End(false);
+		return true;
+	}
+	return false;
+}
+
+bool DeadlineGroup::Execute()
+{
+	ParallelGroup::Execute();
+	return CommandCount == 0 || !Running[0];
+}
+
+void TaskCommand::Initialize()
+{
+	Resume = 0;
+	Step = 0;
+	Awaited = NULL;
+}
+
+void TaskCommand::End(bool interrupted)
+{
+	if(interrupted && Awaited != NULL) Awaited->End(true);
+	Awaited = NULL;
+}
+
+void CommandScheduler::Remove(int index)
+{
+	for(int i = index; i < ScheduledCount - 1; i++) Scheduled[i] = Scheduled[i + 1];
+	ScheduledCount--;
+}
+
+bool CommandScheduler::Schedule(Command *command)
+{
+	if(IsScheduled(command)) return true;
+	for(int i = ScheduledCount - 1; i >= 0; i--)
+	{
+		if((Scheduled[i]->GetRequirements() & command->GetRequirements()) == 0) continue;
+		Command *interrupted = Scheduled[i];
+		Remove(i);
+		interrupted->End(true);
+	}
+	if(ScheduledCount == kMaxScheduled)
+	{
+		Logger::Write(kLogSchedulerFull,ScheduledCount);
+		return false;
+	}
+	Scheduled[ScheduledCount++] = command;
+	command->Initialize();
+	return true;
+}
+
+void CommandScheduler::Cancel(Command *command)
+{
+	for(int i = 0; i < ScheduledCount; i++)
+	{
+		if(Scheduled[i] != command) continue;
+		Remove(i);
+		command->End(true);
+		return;
+	}
+}
+
+void CommandScheduler::CancelAll()
+{
+	while(ScheduledCount > 0)
+	{
+		Command *command = Scheduled[--ScheduledCount];
+		command->End(true);
+	}
+}
+
+bool CommandScheduler::IsScheduled(const Command *command) const
+{
+	for(int i = 0; i < ScheduledCount; i++)
+		if(Scheduled[i] == command) return true;
+	return false;
+}
+
+void CommandScheduler::Run()
+{
+	for(int i = 0; i < ScheduledCount; )
+	{
+		Command *command = Scheduled[i];
+		if(command->Execute())
+		{
+			Remove(i);
+			command->End(false);
+		}
+		else i++;
+	}
+}
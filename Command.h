@@ -0,0 +1,170 @@
+/*
+ * Command.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Commands run by a CommandScheduler once per 50Hz cycle, so the drive and
+ *  the mechanisms can move at the same time instead of one AutoState after
+ *  another.  A command says which subsystems it drives (Requirements), and
+ *  scheduling a command ends any running command that needs one of the same
+ *  subsystems.
+ *
+ *  Groups run other commands:
+ *     SequentialGroup   one after another, the next starts the cycle after one finishes
+ *     ParallelGroup     all at once, done when all are done
+ *     RaceGroup         all at once, done when the first is done, the rest are interrupted
+ *     DeadlineGroup     all at once, done when the first command is done
+ *  The commands in a parallel, race or deadline group must not share
+ *  subsystems.  A command can be in more than one group as long as the
+ *  groups never run at the same time.
+ *
+ *  A TaskCommand is written as one function that waits on each step in
+ *  turn, with TASK_AWAIT and TASK_RUN, instead of a switch on a state
+ *  number.  C++14 has no coroutines, so the task keeps the line it is
+ *  waiting on and its Execute switches back to that line the next cycle
+ *  (a protothread).  Anything a task needs across a wait is a member, not
+ *  a local.
+ *
+ *  Groups, tasks and the scheduler keep fixed tables, nothing is allocated
+ *  while commands run.
+ *
+ */
+
+#ifndef SRC_COMMAND_H_
+#define SRC_COMMAND_H_
+
+#include <initializer_list>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+	kSubsystemDrive = 1,
+	kSubsystemLift = 2,
+	kSubsystemArm = 4,
+	kSubsystemGrip = 8
+} Subsystem;
+
+class Command
+{
+protected:
+	uint32_t Requirements;
+public:
+	Command(uint32_t requirements = 0) : Requirements(requirements) {}
+	virtual ~Command() {}
+	//called when the command starts
+	virtual void Initialize() {}
+	//called once a cycle until it returns true
+	virtual bool Execute() = 0;
+	//called when it finishes or is interrupted
+	virtual void End(bool /*interrupted*/) {}
+	//the step it is on, for the telemetry
+	virtual int GetStep() const { return 0; }
+	uint32_t GetRequirements() const { return Requirements; }
+};
+
+class CommandGroup : public Command
+{
+public:
+	static const int kMaxCommands = 8;	//more are logged and left out
+protected:
+	Command *Commands[kMaxCommands];
+	int CommandCount = 0;
+	bool Running[kMaxCommands];
+	CommandGroup(std::initializer_list<Command *> commands);
+	//interrupt the commands still running
+	void EndRunning();
+};
+
+class SequentialGroup : public CommandGroup
+{
+private:
+	int Current = 0;
+public:
+	SequentialGroup(std::initializer_list<Command *> commands) : CommandGroup(commands) {}
+	void Initialize();
+	bool Execute();
+	void End(bool interrupted);
+	int GetStep() const { return Current; }
+};
+
+class ParallelGroup : public CommandGroup
+{
+public:
+	ParallelGroup(std::initializer_list<Command *> commands) : CommandGroup(commands) {}
+	void Initialize();
+	bool Execute();
+	void End(bool interrupted);
+};
+
+class RaceGroup : public ParallelGroup
+{
+public:
+	RaceGroup(std::initializer_list<Command *> commands) : ParallelGroup(commands) {}
+	bool Execute();
+};
+
+//the first command is the deadline
+class DeadlineGroup : public ParallelGroup
+{
+public:
+	DeadlineGroup(std::initializer_list<Command *> commands) : ParallelGroup(commands) {}
+	bool Execute();
+};
+
+//Execute is TASK_BEGIN, the steps, then TASK_END
+class TaskCommand : public Command
+{
+protected:
+	int Resume = 0;		//line of the wait to go back to, 0 at the start
+	int Step = 0;		//waits reached
+	Command *Awaited = NULL;	//the command TASK_RUN is running
+public:
+	TaskCommand(uint32_t requirements = 0) : Command(requirements) {}
+	void Initialize();
+	//interrupts the command it is running
+	void End(bool interrupted);
+	int GetStep() const { return Step; }
+};
+
+//marks the deliberate fall into a wait's case label for -Wimplicit-fallthrough
+#if defined(__clang__)
+#define TASK_FALLTHROUGH [[clang::fallthrough]]
+#elif defined(__GNUC__) && __GNUC__ >= 7
+#define TASK_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define TASK_FALLTHROUGH
+#endif
+
+//only one TASK_AWAIT or TASK_RUN on a line
+#define TASK_BEGIN() switch(Resume) { case 0:
+//wait until done is true, it is evaluated again every cycle
+#define TASK_AWAIT(done) \
+	Step++; Resume = __LINE__; TASK_FALLTHROUGH; case __LINE__: if(!(done)) return false
+//run a command until it finishes
+#define TASK_RUN(command) \
+	Awaited = (command); Awaited->Initialize(); \
+	TASK_AWAIT(Awaited->Execute()); Awaited->End(false); Awaited = NULL
+#define TASK_END() } Resume = -1; return true
+
+class CommandScheduler
+{
+public:
+	static const int kMaxScheduled = 8;
+private:
+	Command *Scheduled[kMaxScheduled];
+	int ScheduledCount = 0;
+
+	void Remove(int index);
+public:
+	//start a command, interrupting any that needs one of its subsystems
+	//false if the table is full
+	bool Schedule(Command *command);
+	void Cancel(Command *command);
+	void CancelAll();
+	bool IsScheduled(const Command *command) const;
+	//run every scheduled command for this cycle, the finished ones are removed
+	void Run();
+};
+
+#endif /* SRC_COMMAND_H_ */
@@ -0,0 +1,141 @@
+/*
+ * DriveLoop.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "DriveLoop.h"
+#include <math.h>
+
+DriveLoop::DriveLoop(RobotIO *io, double feetPerPulse) :
+	IO(io), LoopOdometry(feetPerPulse), FeetPerPulse(feetPerPulse), Timing(io,0.002)
+{
+}
+
+void DriveLoop::Start(Profile *profile, const Pose2d &pose, float headingOffset)
+{
+	Command.Generation++;
+	Command.Run = true;
+	Command.Plan = profile;
+	Command.HeadingOffset = headingOffset;
+	Command.StartPose = pose;
+	Commands.Write(Command);
+}
+
+void DriveLoop::Stop()
+{
+	Command.Generation++;
+	Command.Run = false;
+	Commands.Write(Command);
+}
+
+void DriveLoop::RequestReport()
+{
+	Command.ReportCount++;
+	Commands.Write(Command);
+}
+
+bool DriveLoop::IsCompleted()
+{
+	const DriveStatus &status = Status.Read();
+	return Command.Run && status.Generation == Command.Generation && status.Completed;
+}
+
+bool DriveLoop::IsStopped()
+{
+	return !Command.Run && Status.Read().Generation == Command.Generation;
+}
+
+//same as Robot::GetHeading
+double DriveLoop::GetHeading(Profile *profile, float headingOffset)
+{
+	double offsetYaw = profile->GetNormalizedHeading(IO->GetYaw()) - headingOffset;
+	if(offsetYaw < 0) offsetYaw += 360;
+	return offsetYaw;
+}
+
+void DriveLoop::Tick()
+{
+	Timing.BeginCycle();
+	const DriveCommand &command = Commands.Read();
+	if(command.ReportCount != ReportCount)
+	{
+		ReportCount = command.ReportCount;
+		Timing.Report();
+	}
+	if(command.Generation != State.Generation)
+	{
+		//stopped part way through a profile, don't leave the motors running
+		if(!command.Run && !State.Completed) IO->SetDrive(0.0,0.0);
+		State = DriveStatus();
+		State.Generation = command.Generation;
+		if(command.Run)
+			LoopOdometry.Reset(command.StartPose,IO->GetLeftEncoder(),IO->GetRightEncoder(),
+					GetHeading(command.Plan,command.HeadingOffset));
+	}
+	if(command.Run && !State.Completed)
+	{
+		Profile *profile = command.Plan;
+		double heading = GetHeading(profile,command.HeadingOffset);
+		int rightCount = IO->GetRightEncoder();
+		LoopOdometry.Update(IO->GetLeftEncoder(),rightCount,heading);
+		double distance = fabs(rightCount * FeetPerPulse);
+		profile->ExecuteProfile(heading,distance,LoopOdometry.GetPose());
+		double left, right;
+		CurveToWheels(profile->OutputMagnitude,profile->Curve,&left,&right);
+		Desaturate(&left,&right);
+		IO->SetDrive(left,-right);
+
+		State.Completed = profile->ProfileCompleted;
+		State.ProfileStep = profile->ProfileStep;
+		State.Heading = heading;
+		State.Distance = distance;
+		State.OutputMagnitude = profile->OutputMagnitude;
+		State.Curve = profile->Curve;
+		State.Left = left;
+		State.Right = -right;
+		State.SteerP = profile->GetSteerPID().GetP();
+		State.SteerI = profile->GetSteerPID().GetI();
+		State.SteerD = profile->GetSteerPID().GetD();
+		State.TurnP = profile->GetTurnPID().GetP();
+		State.TurnI = profile->GetTurnPID().GetI();
+		State.TurnD = profile->GetTurnPID().GetD();
+		State.LoopPose = LoopOdometry.GetPose();
+	}
+	Status.Write(State);
+	Timing.EndCycle();
+}
+
+void DriveLoop::CurveToWheels(double outputMagnitude, double curve, double *left, double *right)
+{
+	double m_sensitivity = 0.75;
+	if (curve < 0)
+	{
+		double value = std::log(-curve);
+		double ratio = (value - m_sensitivity) / (value + m_sensitivity);
+		if (ratio == 0) ratio = .0000000001;
+		*left = outputMagnitude / ratio;
+		*right = outputMagnitude;
+	}
+	else if (curve > 0)
+	{
+		double value = std::log(curve);
+		double ratio = (value - m_sensitivity) / (value + m_sensitivity);
+		if (ratio == 0) ratio = .0000000001;
+		*left = outputMagnitude;
+		*right = outputMagnitude / ratio;
+	}
+	else
+	{
+		*left = outputMagnitude;
+		*right = outputMagnitude;
+	}
+}
+
+void DriveLoop::Desaturate(double *left, double *right)
+{
+	double larger = fmax(fabs(*left),fabs(*right));
+	if(larger <= 1.0) return;
+	*left /= larger;
+	*right /= larger;
+}
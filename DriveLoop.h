@@ -0,0 +1,116 @@
+/*
+ * DriveLoop.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Runs the autonomous Profile and the drive motors at a higher rate than the
+ *  50Hz TimedRobot loop (200Hz by default, from a Notifier on the roboRIO),
+ *  so the trajectory and steering loops see a new distance and heading every
+ *  5ms.  The 50Hz loop keeps the mechanisms and the autonomous commands.
+ *
+ *  The loops only talk through two TripleBuffers: the 50Hz loop publishes a
+ *  DriveCommand (run a profile from a pose, or stop), the drive loop answers
+ *  every tick with a DriveStatus.  The Profile belongs to the drive loop from
+ *  Start until the status shows it completed or acknowledges a Stop, the 50Hz
+ *  loop must not touch it in between.
+ *
+ *  The drive loop reads the sensors and sets the drive through the hardware
+ *  RobotIO, not the telemetry recorder, so its outputs are recorded from the
+ *  status once per 50Hz cycle.
+ *
+ */
+
+#ifndef SRC_DRIVELOOP_H_
+#define SRC_DRIVELOOP_H_
+
+#include "RobotIO.h"
+#include "Profile.h"
+#include "Odometry.h"
+#include "LoopTiming.h"
+#include "TripleBuffer.h"
+
+struct DriveCommand
+{
+	uint32_t Generation = 0;	//changes for every Start and Stop
+	uint32_t ReportCount = 0;	//changes when the 50Hz loop wants the timing report
+	bool Run = false;			//drive the profile until it completes
+	Profile *Plan = NULL;		//profile to drive, built on the hardware clock
+	float HeadingOffset = 0.0f;	//Robot::HeadingOffset when the profile started
+	Pose2d StartPose;			//field pose when the profile started
+};
+
+struct DriveStatus
+{
+	uint32_t Generation = 0;	//command this status answers
+	bool Completed = false;
+	int ProfileStep = 0;
+	double Heading = 0.0;
+	double Distance = 0.0;
+	float OutputMagnitude = 0.0f;
+	float Curve = 0.0f;
+	double Left = 0.0;			//drive outputs as sent to RobotIO::SetDrive
+	double Right = 0.0;
+	double SteerP = 0.0;
+	double SteerI = 0.0;
+	double SteerD = 0.0;
+	double TurnP = 0.0;
+	double TurnI = 0.0;
+	double TurnD = 0.0;
+	Pose2d LoopPose;
+};
+
+class DriveLoop
+{
+private:
+	RobotIO *IO;
+	Odometry LoopOdometry;
+	double FeetPerPulse;
+	LoopTiming Timing;
+	TripleBuffer<DriveCommand> Commands;
+	TripleBuffer<DriveStatus> Status;
+	//50Hz loop side
+	DriveCommand Command;
+	//drive loop side
+	DriveStatus State;
+	uint32_t ReportCount = 0;
+
+	double GetHeading(Profile *profile, float headingOffset);
+public:
+	static const int kDefaultRate = 200;	//Hz
+
+	//io must be the hardware, the profiles must be built on io's clock
+	DriveLoop(RobotIO *io, double feetPerPulse);
+	//which way each encoder counts driving forward (Odometry), set before the first Tick
+	void SetEncoderSigns(double left, double right)
+	{
+		LoopOdometry.LeftEncoderSign = left;
+		LoopOdometry.RightEncoderSign = right;
+	}
+
+	//********* 50Hz LOOP **********
+	//hand a loaded profile to the drive loop
+	void Start(Profile *profile, const Pose2d &pose, float headingOffset);
+	//stop driving, the profile is free once IsStopped
+	void Stop();
+	//ask the drive loop to log its tick timing
+	void RequestReport();
+	//true from Start until Stop
+	bool IsActive() const { return Command.Run; }
+	//the drive loop has finished the profile given by the last Start
+	bool IsCompleted();
+	//the drive loop has seen the last Stop and left the profile alone
+	bool IsStopped();
+	//newest status, valid until the next call
+	const DriveStatus &GetStatus() { return Status.Read(); }
+
+	//********* DRIVE LOOP **********
+	//call at the drive loop rate
+	void Tick();
+
+	//wheel outputs for Robot::Auto_Drive's magnitude and curve, before Desaturate
+	static void CurveToWheels(double outputMagnitude, double curve, double *left, double *right);
+	//scale both wheel outputs down together so neither is past 1.0, keeping the turn's radius
+	static void Desaturate(double *left, double *right);
+};
+
+#endif /* SRC_DRIVELOOP_H_ */
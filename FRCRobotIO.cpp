@@ -0,0 +1,217 @@
+/*
+ * FRCRobotIO.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Not built for the headless simulator (ROBOT_SIM), which has no WPILib.
+ */
+
+#ifndef ROBOT_SIM
+
+#include "FRCRobotIO.h"
+
+FRCRobotIO::FRCRobotIO(WPI_TalonSRX *motorLF, WPI_TalonSRX *motorRF,
+		VictorSP *motorLift, VictorSP *motorArm, VictorSP *motorGrip,
+		AnalogPotentiometer *potArm, DigitalInput *limitLiftHi, DigitalInput *limitLiftLo,
+		DigitalInput *thumbWheel_1, DigitalInput *thumbWheel_2,
+		DigitalInput *thumbWheel_4, DigitalInput *thumbWheel_8, AHRS *gyro)
+{
+	MotorLF = motorLF;
+	MotorRF = motorRF;
+	MotorLift = motorLift;
+	MotorArm = motorArm;
+	MotorGrip = motorGrip;
+	PotArm = potArm;
+	LimitLiftHi = limitLiftHi;
+	LimitLiftLo = limitLiftLo;
+	ThumbWheel_1 = thumbWheel_1;
+	ThumbWheel_2 = thumbWheel_2;
+	ThumbWheel_4 = thumbWheel_4;
+	ThumbWheel_8 = thumbWheel_8;
+	Gyro = gyro;
+}
+
+uint64_t FRCRobotIO::GetFPGATime()
+{
+	return RobotController::GetFPGATime();
+}
+
+double FRCRobotIO::GetYaw()
+{
+	return Gyro->GetYaw();
+}
+
+int FRCRobotIO::GetLeftEncoder()
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	return MotorLF->GetSelectedSensorPosition(0);
+}
+
+int FRCRobotIO::GetRightEncoder()
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	return MotorRF->GetSelectedSensorPosition(0);
+	//return MotorRF->GetSensorCollection().GetQuadraturePosition();
+}
+
+void FRCRobotIO::ZeroEncoders()
+{
+	if(CanBus != NULL) CanBus->CountCall(2);
+	MotorLF->SetSelectedSensorPosition(0,0,0);
+	MotorRF->SetSelectedSensorPosition(0,0,0);
+}
+
+double FRCRobotIO::GetArmPosition()
+{
+	return PotArm->Get();
+}
+
+bool FRCRobotIO::GetLimitLiftHi()
+{
+	return LimitLiftHi->Get();
+}
+
+bool FRCRobotIO::GetLimitLiftLo()
+{
+	return LimitLiftLo->Get();
+}
+
+bool FRCRobotIO::GetThumbWheelBit(int bit)
+{
+	switch(bit)
+	{
+		case 1: return ThumbWheel_1->Get();
+		case 2: return ThumbWheel_2->Get();
+		case 4: return ThumbWheel_4->Get();
+		case 8: return ThumbWheel_8->Get();
+		default: return false;
+	}
+}
+
+std::string FRCRobotIO::GetGameData()
+{
+	return frc::DriverStation::GetInstance().GetGameSpecificMessage();
+}
+
+void FRCRobotIO::SetDrive(double left, double right)
+{
+	if(CanBus != NULL) CanBus->CountCall(2);
+	MotorLF->Set(left);
+	MotorRF->Set(right);
+}
+
+void FRCRobotIO::SetLift(double speed)
+{
+	MotorLift->Set(speed);
+}
+
+void FRCRobotIO::SetArm(double speed)
+{
+	MotorArm->Set(speed);
+}
+
+void FRCRobotIO::SetGrip(double speed)
+{
+	MotorGrip->Set(speed);
+}
+
+TalonProfileBuffer::TalonProfileBuffer(WPI_TalonSRX *motor, double kP, double kF, CanScheduler *canBus)
+{
+	Motor = motor;
+	CanBus = canBus;
+	Motor->Config_kP(0,kP,10);
+	Motor->Config_kF(0,kF,10);
+	//point durations come from the points
+	Motor->ConfigMotionProfileTrajectoryPeriod(0,10);
+	//send the bottom buffer points at 200Hz, twice the rate they are used
+	Motor->ChangeMotionControlFramePeriod(5);
+}
+
+bool TalonProfileBuffer::PushPoint(const MotionPoint &point)
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	ctre::phoenix::motion::TrajectoryPoint tp;
+	tp.position = point.Position;
+	tp.velocity = point.Velocity;
+	tp.headingDeg = 0;
+	tp.auxiliaryPos = 0;
+	tp.profileSlotSelect0 = 0;
+	tp.profileSlotSelect1 = 0;
+	tp.isLastPoint = point.IsLast;
+	tp.zeroPos = false;
+	tp.timeDur = ctre::phoenix::motion::TrajectoryDuration(point.DurationMs);
+	return Motor->PushMotionProfileTrajectory(tp) == ErrorCode::OK;
+}
+
+void TalonProfileBuffer::ProcessBuffer()
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	Motor->ProcessMotionProfileBuffer();
+}
+
+void TalonProfileBuffer::GetStatus(MotionBufferStatus *status)
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	ctre::phoenix::motion::MotionProfileStatus mps;
+	Motor->GetMotionProfileStatus(mps);
+	status->TopBufferRem = mps.topBufferRem;
+	status->TopBufferCnt = mps.topBufferCnt;
+	status->BtmBufferCnt = mps.btmBufferCnt;
+	status->HasUnderrun = mps.hasUnderrun;
+	status->IsUnderrun = mps.isUnderrun;
+	status->ActivePointValid = mps.activePointValid;
+	status->IsLast = mps.isLast;
+	switch(mps.outputEnable)
+	{
+		case SetValueMotionProfile::Enable: status->Mode = kMotionEnable; break;
+		case SetValueMotionProfile::Hold: status->Mode = kMotionHold; break;
+		default: status->Mode = kMotionDisable; break;
+	}
+}
+
+void TalonProfileBuffer::Clear()
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	Motor->ClearMotionProfileTrajectories();
+}
+
+void TalonProfileBuffer::ClearUnderrun()
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	Motor->ClearMotionProfileHasUnderrun(0);
+}
+
+void TalonProfileBuffer::SetMode(MotionProfileMode mode)
+{
+	if(CanBus != NULL) CanBus->CountCall();
+	switch(mode)
+	{
+		case kMotionEnable: Motor->Set(ControlMode::MotionProfile,int(SetValueMotionProfile::Enable)); break;
+		case kMotionHold: Motor->Set(ControlMode::MotionProfile,int(SetValueMotionProfile::Hold)); break;
+		default: Motor->Set(ControlMode::MotionProfile,int(SetValueMotionProfile::Disable)); break;
+	}
+}
+
+int TalonCanDevice::GetDeviceID()
+{
+	return Motor->GetDeviceID();
+}
+
+bool TalonCanDevice::SetStatusFramePeriod(CanStatusFrame frame, int periodMs)
+{
+	static const StatusFrameEnhanced kFrames[kCanStatusCount] =
+	{
+		StatusFrameEnhanced::Status_1_General,
+		StatusFrameEnhanced::Status_2_Feedback0,
+		StatusFrameEnhanced::Status_3_Quadrature,
+		StatusFrameEnhanced::Status_4_AinTempVbat,
+		StatusFrameEnhanced::Status_8_PulseWidth,
+		StatusFrameEnhanced::Status_9_MotProfBuffer,
+		StatusFrameEnhanced::Status_10_MotionMagic,
+		StatusFrameEnhanced::Status_13_Base_PIDF0,
+		StatusFrameEnhanced::Status_14_Turn_PIDF1,
+	};
+	return Motor->SetStatusFramePeriod(kFrames[frame],periodMs,10) == ErrorCode::OK;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * FRCRobotIO.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  roboRIO backend for RobotIO.  Wraps the devices created in Robot::RobotInit.
+ *  TalonProfileBuffer feeds a drive Talon's motion profile executer for the
+ *  MotionStreamer, TalonCanDevice sets a Talon's status frames for the
+ *  CanScheduler.  Talon calls are counted on the scheduler when one is set.
+ *
+ */
+
+#ifndef SRC_FRCROBOTIO_H_
+#define SRC_FRCROBOTIO_H_
+
+#include "RobotIO.h"
+#include "MotionProfileBuffer.h"
+#include "CanScheduler.h"
+#include "AHRS.h"
+#include "ctre/Phoenix.h"
+#include "WPILib.h"
+
+class FRCRobotIO : public RobotIO
+{
+private:
+	WPI_TalonSRX *MotorLF;
+	WPI_TalonSRX *MotorRF;
+	VictorSP *MotorLift;
+	VictorSP *MotorArm;
+	VictorSP *MotorGrip;
+	AnalogPotentiometer *PotArm;
+	DigitalInput *LimitLiftHi;
+	DigitalInput *LimitLiftLo;
+	DigitalInput *ThumbWheel_1;
+	DigitalInput *ThumbWheel_2;
+	DigitalInput *ThumbWheel_4;
+	DigitalInput *ThumbWheel_8;
+	AHRS *Gyro;
+	CanScheduler *CanBus = NULL;
+public:
+	FRCRobotIO(WPI_TalonSRX *motorLF, WPI_TalonSRX *motorRF,
+			VictorSP *motorLift, VictorSP *motorArm, VictorSP *motorGrip,
+			AnalogPotentiometer *potArm, DigitalInput *limitLiftHi, DigitalInput *limitLiftLo,
+			DigitalInput *thumbWheel_1, DigitalInput *thumbWheel_2,
+			DigitalInput *thumbWheel_4, DigitalInput *thumbWheel_8, AHRS *gyro);
+	void SetCanScheduler(CanScheduler *canBus) { CanBus = canBus; }
+
+	uint64_t GetFPGATime();
+	double GetYaw();
+	int GetLeftEncoder();
+	int GetRightEncoder();
+	void ZeroEncoders();
+	double GetArmPosition();
+	bool GetLimitLiftHi();
+	bool GetLimitLiftLo();
+	bool GetThumbWheelBit(int bit);
+	std::string GetGameData();
+
+	void SetDrive(double left, double right);
+	void SetLift(double speed);
+	void SetArm(double speed);
+	void SetGrip(double speed);
+};
+
+//the Talon's sensor phase must make positive output count the encoder up
+class TalonProfileBuffer : public MotionProfileBuffer
+{
+private:
+	WPI_TalonSRX *Motor;
+	CanScheduler *CanBus;
+public:
+	//kP and kF go in slot 0 of the Talon (see MotionProfileBuffer.h for units)
+	TalonProfileBuffer(WPI_TalonSRX *motor, double kP, double kF, CanScheduler *canBus = NULL);
+
+	bool PushPoint(const MotionPoint &point);
+	void ProcessBuffer();
+	void GetStatus(MotionBufferStatus *status);
+	void Clear();
+	void ClearUnderrun();
+	void SetMode(MotionProfileMode mode);
+};
+
+class TalonCanDevice : public CanDevice
+{
+private:
+	WPI_TalonSRX *Motor;
+public:
+	TalonCanDevice(WPI_TalonSRX *motor) : Motor(motor) {}
+	int GetDeviceID();
+	bool SetStatusFramePeriod(CanStatusFrame frame, int periodMs);
+};
+
+#endif /* SRC_FRCROBOTIO_H_ */
@@ -0,0 +1,194 @@
+/*
+ * Logger.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Logger.h"
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//printed with all six values as doubles, use %.0f for counts and step numbers
+static const char *LogFormats[kLogEventCount] =
+{
+	"MOVE %.0f Start - Tgt: %5.2f Dist: %5.2f StartHeading: %5.2f\n",
+	"MOVE %.0f Done - Dist: %5.2f EndHeading: %5.2f\n",
+	"TURN %.0f Start - Tgt: %5.2f Angle: %5.2f Error: %5.2f\n",
+	"TURN %.0f Done - Angle: %5.2f Error: %5.2f\n",
+	"PAUSE %.0f Start - Duration: %.0f\n",
+	"PAUSE %.0f Done - Elapsed: %.0f\n",
+	"CURVE %.0f Start - Tgt: %5.2f Dist: %5.2f StartHeading: %5.2f\n",
+	"CURVE %.0f Done - Dist: %5.2f EndHeading: %5.2f\n",
+	"SPLINE %.0f Start - Tgt: %5.2f StartHeading: %5.2f\n",
+	"SPLINE %.0f Done - Dist: %5.2f EndHeading: %5.2f\n",
+	"Step %.0f Motion Time = %.0f ms\n",
+	"[NewStep] profile full at %.0f steps\n",
+	"[BuildTrajectory] trajectory pool full at step %.0f\n",
+	"[AddMove] step %.0f table was built for other limits, planned at run time\n",
+	"[AddSpline] could not build path for step %.0f\n",
+	"Step %.0f heading= %.1f dist= %.2f speed= %.2f curve= %.2f\n",
+	"ThumbWheel= %.0f\n",
+	"SWITCH Chosen\n",
+	"SCALE Chosen\n",
+	"Auto %.0f Completed\n",
+	"ArmPos= %.1f LiftLO=%.0f LiftHI=%.0f Yaw=%.1f Dist=%.1f\n",
+	"[LoopTiming] overrun %.2f ms, budget %.1f ms, %.0f overruns\n",
+	"[LoopTiming] period p50 %.2f p99 %.2f max %.2f ms over %.0f cycles\n",
+	"[LoopTiming] execution p50 %.3f p99 %.3f max %.3f ms, %.0f overruns of %.1f ms budget\n",
+	"[MotionStreamer] enabled with %.0f points, %.0f in the Talons\n",
+	"[MotionStreamer] underrun at point %.0f, left %.0f right %.0f buffered, %.0f underruns\n",
+	"[MotionStreamer] %.0f points done in %.0f ms, %.0f underruns\n",
+	"[CanScheduler] device %.0f refused frame %.0f at %.0f ms\n",
+	"[CanScheduler] bus %.1f%% (%.1f%% at defaults) for %.0f devices, room for %.0f more\n",
+	"[CanScheduler] %.1f calls per cycle, max %.0f over %.0f cycles\n",
+	"[CommandScheduler] full with %.0f commands\n",
+	"[CommandGroup] %.0f commands given, only the first %.0f will run\n",
+	"[AutoScript] %.0f commands loaded in %.0f us, plans built in %.0f us\n",
+	"[AutoScript] not loaded, error at line %.0f, keeping the last script\n",
+};
+
+static const int kMaxRings = 4;
+static LogRing Rings[kMaxRings];
+static std::atomic<int> RingCount(0);
+static thread_local LogRing *ThreadRing = NULL;
+static thread_local Clock *LogClock = NULL;	//each robot (sim trials run several) stamps with its own clock
+static std::mutex FlushMutex;		//one consumer at a time, never taken by a producer
+static uint32_t ReportedDrops[kMaxRings];
+static std::atomic<uint32_t> RefusedThreads(0);		//AttachThread calls past kMaxRings
+static std::atomic<uint32_t> UnattachedDrops(0);	//records written by threads without a ring
+static uint32_t ReportedRefused = 0;
+static uint32_t ReportedUnattached = 0;
+static std::thread *Flusher = NULL;
+static std::atomic<bool> FlusherRun(false);
+
+bool LogRing::Push(const LogRecord &record)
+{
+	uint32_t head = Head.load(std::memory_order_relaxed);
+	if(head - Tail.load(std::memory_order_acquire) >= kSize)
+	{
+		Dropped.fetch_add(1,std::memory_order_relaxed);
+		return false;
+	}
+	Records[head & (kSize - 1)] = record;
+	Head.store(head + 1,std::memory_order_release);
+	return true;
+}
+
+bool LogRing::Pop(LogRecord *record)
+{
+	uint32_t tail = Tail.load(std::memory_order_relaxed);
+	if(tail == Head.load(std::memory_order_acquire)) return false;
+	*record = Records[tail & (kSize - 1)];
+	Tail.store(tail + 1,std::memory_order_release);
+	return true;
+}
+
+void Logger::Init(Clock *clock)
+{
+	LogClock = clock;
+}
+
+bool Logger::AttachThread()
+{
+	if(ThreadRing != NULL) return true;
+	int ndx = RingCount.fetch_add(1);
+	if(ndx >= kMaxRings)
+	{
+		RingCount.store(kMaxRings);
+		RefusedThreads.fetch_add(1,std::memory_order_relaxed);
+		return false;
+	}
+	ThreadRing = &Rings[ndx];
+	return true;
+}
+
+void Logger::Write(LogEvent event, double a, double b, double c, double d, double e, double f)
+{
+	LogRing *ring = ThreadRing;
+	if(ring == NULL)
+	{
+		UnattachedDrops.fetch_add(1,std::memory_order_relaxed);
+		return;
+	}
+	LogRecord record;
+	record.Time = LogClock != NULL ? LogClock->GetFPGATime() : 0;
+	record.Event = event;
+	record.Value[0] = a;
+	record.Value[1] = b;
+	record.Value[2] = c;
+	record.Value[3] = d;
+	record.Value[4] = e;
+	record.Value[5] = f;
+	ring->Push(record);
+}
+
+int Logger::Flush()
+{
+	std::lock_guard<std::mutex> lock(FlushMutex);
+	int count = 0;
+	int rings = RingCount.load();
+	if(rings > kMaxRings) rings = kMaxRings;
+	for(int ndx = 0; ndx < rings; ndx++)
+	{
+		LogRecord record;
+		while(Rings[ndx].Pop(&record))
+		{
+			if(record.Event >= kLogEventCount) continue;
+			printf("[%8.3f] ",record.Time / 1000000.0);
+			printf(LogFormats[record.Event],record.Value[0],record.Value[1],record.Value[2],
+					record.Value[3],record.Value[4],record.Value[5]);
+			count++;
+		}
+		uint32_t dropped = Rings[ndx].Dropped.load(std::memory_order_relaxed);
+		if(dropped != ReportedDrops[ndx])
+		{
+			printf("[Logger] ring %i dropped %u records\n",ndx,dropped - ReportedDrops[ndx]);
+			ReportedDrops[ndx] = dropped;
+		}
+	}
+	uint32_t refused = RefusedThreads.load(std::memory_order_relaxed);
+	if(refused != ReportedRefused)
+	{
+		printf("[Logger] %u threads refused a ring, all %i are in use\n",refused - ReportedRefused,kMaxRings);
+		ReportedRefused = refused;
+	}
+	uint32_t unattached = UnattachedDrops.load(std::memory_order_relaxed);
+	if(unattached != ReportedUnattached)
+	{
+		printf("[Logger] dropped %u records from threads without a ring\n",unattached - ReportedUnattached);
+		ReportedUnattached = unattached;
+	}
+	if(count > 0) fflush(stdout);
+	return count;
+}
+
+void Logger::StartFlusher(double period)
+{
+	if(Flusher != NULL) return;
+	FlusherRun = true;
+	Flusher = new std::thread([period]()
+	{
+		//below the robot threads, console writes can block
+		setpriority(PRIO_PROCESS,syscall(SYS_gettid),10);
+		while(FlusherRun)
+		{
+			Flush();
+			std::this_thread::sleep_for(std::chrono::duration<double>(period));
+		}
+		Flush();
+	});
+}
+
+void Logger::Stop()
+{
+	if(Flusher == NULL) return;
+	FlusherRun = false;
+	Flusher->join();
+	delete Flusher;
+	Flusher = NULL;
+}
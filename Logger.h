@@ -0,0 +1,108 @@
+/*
+ * Logger.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Binary event log for the control loop.  Logger::Write copies a fixed size
+ *  record into a single producer / single consumer ring owned by the calling
+ *  thread, no locks, no formatting and no system calls.  Logger::Flush pops
+ *  the records and prints them using the format table in Logger.cpp, either
+ *  from the background flusher thread on the robot or from the sim's loop.
+ *
+ *  Each thread that writes must call Logger::AttachThread once, there are four
+ *  rings.  Records from threads without a ring, or written while a ring is
+ *  full, are counted and dropped rather than blocking the loop, and Flush
+ *  reports the counts.
+ *
+ */
+
+#ifndef SRC_LOGGER_H_
+#define SRC_LOGGER_H_
+
+#include "RobotIO.h"
+#include <atomic>
+#include <stdint.h>
+
+//keep in step with the format table in Logger.cpp
+typedef enum
+{
+	kLogMoveStart,		//step, target, distance, heading
+	kLogMoveDone,		//step, distance, heading
+	kLogTurnStart,		//step, target, heading, error
+	kLogTurnDone,		//step, heading, error
+	kLogPauseStart,		//step, duration ms
+	kLogPauseDone,		//step, elapsed ms
+	kLogCurveStart,		//step, target, distance, heading
+	kLogCurveDone,		//step, distance, heading
+	kLogSplineStart,	//step, target, heading
+	kLogSplineDone,		//step, distance, heading
+	kLogMotionTime,		//step, ms
+	kLogProfileFull,	//steps
+	kLogTrajPoolFull,	//step
+	kLogTrajTableStale,	//step
+	kLogSplineFailed,	//step
+	kLogProfileTrace,	//step, heading, distance, output, curve
+	kLogThumbWheel,		//value
+	kLogSwitchChosen,
+	kLogScaleChosen,
+	kLogAutoCompleted,	//thumbwheel
+	kLogTeleopStatus,	//arm, lift lo, lift hi, heading, distance
+	kLogLoopOverrun,	//execution ms, budget ms, overruns
+	kLogLoopPeriod,		//p50, p99, max ms, cycles
+	kLogLoopExecution,	//p50, p99, max ms, overruns, budget ms
+	kLogStreamStart,	//points, points in the Talons
+	kLogStreamUnderrun,	//point, left points, right points, underruns
+	kLogStreamDone,		//points, ms, underruns
+	kLogCanFrameRefused,	//device, frame, period ms
+	kLogCanUtilization,	//percent, percent at defaults, devices, headroom devices
+	kLogCanCalls,		//average calls, max calls, cycles
+	kLogSchedulerFull,	//scheduled commands
+	kLogGroupFull,		//commands given, commands kept
+	kLogScriptLoaded,	//commands, load us, plans us
+	kLogScriptFailed,	//line, 0 for the file
+	kLogEventCount
+} LogEvent;
+
+//one cache line
+struct LogRecord
+{
+	uint64_t Time;		//microseconds from the logger's clock
+	uint32_t Event;
+	double Value[6];
+};
+
+class LogRing
+{
+private:
+	static const uint32_t kSize = 512;	//power of two
+	LogRecord Records[kSize];
+	std::atomic<uint32_t> Head;		//next slot to write, only the producer stores
+	std::atomic<uint32_t> Tail;		//next slot to read, only the consumer stores
+public:
+	std::atomic<uint32_t> Dropped;
+
+	LogRing() : Head(0), Tail(0), Dropped(0) {}
+	//producer side, false (and counted as dropped) when full
+	bool Push(const LogRecord &record);
+	//consumer side, false when empty
+	bool Pop(LogRecord *record);
+};
+
+class Logger
+{
+public:
+	//time stamps for the calling thread's records come from clock
+	static void Init(Clock *clock);
+	//give the calling thread a ring, does nothing if it already has one
+	static bool AttachThread();
+	//control loop side, copies one record into this thread's ring
+	static void Write(LogEvent event, double a = 0, double b = 0, double c = 0,
+			double d = 0, double e = 0, double f = 0);
+	//print every queued record, returns the number printed
+	static int Flush();
+	//flush every period seconds on a background thread until Stop
+	static void StartFlusher(double period);
+	static void Stop();
+};
+
+#endif /* SRC_LOGGER_H_ */
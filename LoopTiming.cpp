@@ -0,0 +1,98 @@
+/*
+ * LoopTiming.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "LoopTiming.h"
+#include "Logger.h"
+#include <string.h>
+
+//values below 64 get a bucket each, above that each power of two is split into 32
+int TimingHistogram::BucketIndex(uint64_t value)
+{
+	const uint64_t linear = 2 << kSubBucketBits;
+	if(value < linear) return int(value);
+	if(value >= (uint64_t(1) << kMaxBits)) value = (uint64_t(1) << kMaxBits) - 1;
+	int msb = 63 - __builtin_clzll(value);
+	int shift = msb - kSubBucketBits;
+	int sub = int(value >> shift) - (1 << kSubBucketBits);
+	return int(linear) + ((shift - 1) << kSubBucketBits) + sub;
+}
+
+uint64_t TimingHistogram::BucketUpper(int index)
+{
+	const int linear = 2 << kSubBucketBits;
+	if(index < linear) return index;
+	int shift = ((index - linear) >> kSubBucketBits) + 1;
+	uint64_t sub = (index - linear) & ((1 << kSubBucketBits) - 1);
+	return (((uint64_t(1) << kSubBucketBits) + sub + 1) << shift) - 1;
+}
+
+void TimingHistogram::Reset()
+{
+	memset(Counts,0,sizeof(Counts));
+	Count = 0;
+	Max = 0;
+}
+
+void TimingHistogram::Record(uint64_t value)
+{
+	Counts[BucketIndex(value)]++;
+	Count++;
+	if(value > Max) Max = value;
+}
+
+uint64_t TimingHistogram::GetPercentile(double pct) const
+{
+	if(Count == 0) return 0;
+	uint64_t rank = uint64_t(pct / 100.0 * Count + 0.5);
+	if(rank < 1) rank = 1;
+	uint64_t seen = 0;
+	for(int i = 0; i < kBucketCount; i++)
+	{
+		seen += Counts[i];
+		if(seen >= rank) return BucketUpper(i) < Max ? BucketUpper(i) : Max;
+	}
+	return Max;
+}
+
+LoopTiming::LoopTiming(Clock *clock, double budget)
+{
+	TimingClock = clock;
+	SetBudget(budget);
+}
+
+void LoopTiming::BeginCycle()
+{
+	uint64_t now = TimingClock->GetFPGATime();
+	if(Started) Period.Record(now - CycleStart);
+	CycleStart = now;
+	Started = true;
+}
+
+bool LoopTiming::EndCycle()
+{
+	uint64_t elapsed = TimingClock->GetFPGATime() - CycleStart;
+	Execution.Record(elapsed);
+	if(elapsed <= Budget) return false;
+	Overruns++;
+	Logger::Write(kLogLoopOverrun,elapsed / 1000.0,Budget / 1000.0,Overruns);
+	return true;
+}
+
+void LoopTiming::Reset()
+{
+	Period.Reset();
+	Execution.Reset();
+	Overruns = 0;
+	Started = false;
+}
+
+void LoopTiming::Report()
+{
+	Logger::Write(kLogLoopPeriod,Period.GetPercentile(50) / 1000.0,Period.GetPercentile(99) / 1000.0,
+			Period.GetMax() / 1000.0,Period.GetCount());
+	Logger::Write(kLogLoopExecution,Execution.GetPercentile(50) / 1000.0,Execution.GetPercentile(99) / 1000.0,
+			Execution.GetMax() / 1000.0,Overruns,Budget / 1000.0);
+}
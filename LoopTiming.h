@@ -0,0 +1,75 @@
+/*
+ * LoopTiming.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Timing probe for the TimedRobot periodic functions.  Records the start to
+ *  start period and the execution time of every cycle into fixed bucket
+ *  histograms (log linear like HdrHistogram, about 3% resolution from 1us to
+ *  a minute), counts cycles that run over a budget, and reports p50/p99/max
+ *  on demand.  Recording is a few adds with no allocation or locking, so the
+ *  probe stays on in competition.
+ *
+ *  It must be given the hardware clock, not the cycle latched clock of
+ *  TelemetryRobotIO, or every body would measure 0.
+ *
+ */
+
+#ifndef SRC_LOOPTIMING_H_
+#define SRC_LOOPTIMING_H_
+
+#include "RobotIO.h"
+#include <stdint.h>
+
+class TimingHistogram
+{
+public:
+	static const int kSubBucketBits = 5;	//32 buckets per power of two
+	static const int kMaxBits = 26;			//values up to 67 seconds in microseconds
+	static const int kBucketCount = (2 << kSubBucketBits) + ((kMaxBits - kSubBucketBits - 1) << kSubBucketBits);
+private:
+	uint32_t Counts[kBucketCount];
+	uint64_t Count;
+	uint64_t Max;
+	static int BucketIndex(uint64_t value);
+	static uint64_t BucketUpper(int index);
+public:
+	TimingHistogram() { Reset(); }
+	void Reset();
+	void Record(uint64_t value);
+	uint64_t GetCount() const { return Count; }
+	uint64_t GetMax() const { return Max; }
+	//value that pct percent of the records are at or below, to the bucket resolution
+	uint64_t GetPercentile(double pct) const;
+};
+
+class LoopTiming
+{
+private:
+	Clock *TimingClock;
+	uint64_t CycleStart = 0;
+	bool Started = false;
+	uint64_t Budget;
+	uint32_t Overruns = 0;
+	TimingHistogram Period;
+	TimingHistogram Execution;
+public:
+	//budget in seconds for the body of one cycle
+	LoopTiming(Clock *clock, double budget);
+	void SetBudget(double seconds) { Budget = uint64_t(seconds * 1000000.0); }
+	//call first thing in a periodic function
+	void BeginCycle();
+	//call last thing in a periodic function, returns true if the body ran over the budget
+	bool EndCycle();
+	//the next cycle starts a new period, call when the robot changes mode
+	void Restart() { Started = false; }
+	//clear the histograms and the overrun count
+	void Reset();
+	const TimingHistogram &GetPeriod() const { return Period; }
+	const TimingHistogram &GetExecution() const { return Execution; }
+	uint32_t GetOverruns() const { return Overruns; }
+	//log p50/p99/max of the period and execution time and the overrun count
+	void Report();
+};
+
+#endif /* SRC_LOOPTIMING_H_ */
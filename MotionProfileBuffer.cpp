@@ -0,0 +1,107 @@
+/*
+ * MotionProfileBuffer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "MotionProfileBuffer.h"
+
+SimProfileBuffer::SimProfileBuffer(Clock *clock, double kP, double kF) :
+	BufferClock(clock), kP(kP), kF(kF)
+{
+}
+
+void SimProfileBuffer::Advance()
+{
+	if(Mode != kMotionEnable) return;
+	uint64_t now = BufferClock->GetFPGATime();
+	while(!ActiveValid || now >= ActiveEnd)
+	{
+		if(ActiveValid && Active.IsLast) return;
+		if(BottomCount == 0)
+		{
+			//ran dry before the last point, hold the active point
+			if(ActiveValid && !IsUnderrun) IsUnderrun = HasUnderrun = true;
+			return;
+		}
+		//after an underrun the next point starts when it arrives
+		uint64_t start = ActiveValid && !IsUnderrun ? ActiveEnd : now;
+		Active = Bottom[BottomHead];
+		BottomHead = (BottomHead + 1) % kBottomSize;
+		BottomCount--;
+		ActiveValid = true;
+		IsUnderrun = false;
+		ActiveEnd = start + Active.DurationMs * 1000;
+	}
+}
+
+bool SimProfileBuffer::PushPoint(const MotionPoint &point)
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	if(TopCount == kTopSize) return false;
+	Top[(TopHead + TopCount) % kTopSize] = point;
+	TopCount++;
+	return true;
+}
+
+void SimProfileBuffer::ProcessBuffer()
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	Advance();
+	if(TopCount == 0 || BottomCount == kBottomSize) return;
+	Bottom[(BottomHead + BottomCount) % kBottomSize] = Top[TopHead];
+	BottomCount++;
+	TopHead = (TopHead + 1) % kTopSize;
+	TopCount--;
+}
+
+void SimProfileBuffer::GetStatus(MotionBufferStatus *status)
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	Advance();
+	status->TopBufferRem = kTopSize - TopCount;
+	status->TopBufferCnt = TopCount;
+	status->BtmBufferCnt = BottomCount;
+	status->HasUnderrun = HasUnderrun;
+	status->IsUnderrun = IsUnderrun;
+	status->ActivePointValid = ActiveValid;
+	status->IsLast = ActiveValid && Active.IsLast;
+	status->Mode = Mode;
+}
+
+void SimProfileBuffer::Clear()
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	TopHead = TopCount = 0;
+	BottomHead = BottomCount = 0;
+	ActiveValid = false;
+	IsUnderrun = false;
+}
+
+void SimProfileBuffer::ClearUnderrun()
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	HasUnderrun = false;
+}
+
+void SimProfileBuffer::SetMode(MotionProfileMode mode)
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	Advance();
+	//disabling drops the active point, the next enable starts from the bottom buffer
+	if(mode == kMotionDisable) ActiveValid = false;
+	Mode = mode;
+}
+
+double SimProfileBuffer::GetOutput(double sensorPosition)
+{
+	std::lock_guard<std::mutex> lock(Lock);
+	Advance();
+	if(Mode == kMotionDisable || !ActiveValid) return 0.0;
+	//hold keeps the position without the feed forward, so does an underrun or the last point
+	double velocity = Mode == kMotionEnable && !IsUnderrun && !Active.IsLast ? Active.Velocity : 0.0;
+	double output = (kP * (Active.Position - sensorPosition) + kF * velocity) / 1023.0;
+	if(output > 1.0) return 1.0;
+	if(output < -1.0) return -1.0;
+	return output;
+}
@@ -0,0 +1,108 @@
+/*
+ * MotionProfileBuffer.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  The part of the Talon SRX motion profile API the MotionStreamer uses, so
+ *  the same streaming code drives a real Talon (TalonProfileBuffer in
+ *  FRCRobotIO.h) or the mock below in the simulator.
+ *
+ *  Points are pushed into the top buffer on the RIO side, ProcessBuffer moves
+ *  them down into the bottom buffer in the motor controller, and once enabled
+ *  the controller runs one point per duration with its own position loop
+ *  (position P plus velocity feed forward).  If the bottom buffer runs dry
+ *  before the last point the controller is in underrun: it holds the last
+ *  point and latches HasUnderrun until ClearUnderrun.
+ *
+ *  Units are the Talon's: position in encoder counts, velocity in counts per
+ *  100ms, gains in 1023ths of full output per count of error (kP) and per
+ *  count/100ms of velocity (kF).
+ *
+ */
+
+#ifndef SRC_MOTIONPROFILEBUFFER_H_
+#define SRC_MOTIONPROFILEBUFFER_H_
+
+#include "RobotIO.h"
+#include <mutex>
+#include <stdint.h>
+
+typedef enum {kMotionDisable,kMotionEnable,kMotionHold} MotionProfileMode;
+
+struct MotionPoint
+{
+	double Position = 0.0;
+	double Velocity = 0.0;
+	int DurationMs = 10;		//5, 10 or 20 for the Talon
+	bool IsLast = false;		//hold here when done instead of underrunning
+};
+
+struct MotionBufferStatus
+{
+	int TopBufferRem = 0;		//points that can still be pushed
+	int TopBufferCnt = 0;
+	int BtmBufferCnt = 0;
+	bool HasUnderrun = false;	//latched until ClearUnderrun
+	bool IsUnderrun = false;	//right now
+	bool ActivePointValid = false;
+	bool IsLast = false;		//the active point is the last one
+	MotionProfileMode Mode = kMotionDisable;
+};
+
+class MotionProfileBuffer
+{
+public:
+	virtual ~MotionProfileBuffer() {}
+	//top buffer, false when it is full
+	virtual bool PushPoint(const MotionPoint &point) = 0;
+	//move points from the top buffer to the controller, call at twice the point rate or faster
+	virtual void ProcessBuffer() = 0;
+	virtual void GetStatus(MotionBufferStatus *status) = 0;
+	//empty both buffers
+	virtual void Clear() = 0;
+	virtual void ClearUnderrun() = 0;
+	virtual void SetMode(MotionProfileMode mode) = 0;
+};
+
+//mock Talon for the simulator and bench tools, timed by a Clock
+//each ProcessBuffer moves at most one point down, like the CAN transfer on the robot
+class SimProfileBuffer : public MotionProfileBuffer
+{
+public:
+	static const int kTopSize = 2048;
+	static const int kBottomSize = 128;
+private:
+	Clock *BufferClock;
+	std::mutex Lock;			//pushed from the fill thread, run from the sim loop
+	MotionPoint Top[kTopSize];
+	MotionPoint Bottom[kBottomSize];
+	int TopHead = 0;
+	int TopCount = 0;
+	int BottomHead = 0;
+	int BottomCount = 0;
+	MotionPoint Active;
+	bool ActiveValid = false;
+	uint64_t ActiveEnd = 0;
+	bool HasUnderrun = false;
+	bool IsUnderrun = false;
+	MotionProfileMode Mode = kMotionDisable;
+	double kP;
+	double kF;
+
+	//run the points whose time has passed
+	void Advance();
+public:
+	SimProfileBuffer(Clock *clock, double kP, double kF);
+
+	bool PushPoint(const MotionPoint &point);
+	void ProcessBuffer();
+	void GetStatus(MotionBufferStatus *status);
+	void Clear();
+	void ClearUnderrun();
+	void SetMode(MotionProfileMode mode);
+
+	//what the Talon would drive (-1 to 1, positive makes the sensor count up) for the sensor position
+	double GetOutput(double sensorPosition);
+};
+
+#endif /* SRC_MOTIONPROFILEBUFFER_H_ */
@@ -0,0 +1,167 @@
+/*
+ * MotionStreamer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "MotionStreamer.h"
+#include "Logger.h"
+#include <math.h>
+
+MotionStreamer::MotionStreamer(Clock *clock, MotionProfileBuffer *left, MotionProfileBuffer *right, double feetPerPulse) :
+	StreamClock(clock), Left(left), Right(right), FeetPerPulse(feetPerPulse),
+	Generation(0), Run(false), Finished(0), Acked(0), Underruns(0)
+{
+}
+
+bool MotionStreamer::AddPoint(double position, double velocity)
+{
+	if(PointCount >= kMaxPoints) return false;
+	Points[PointCount].Position = position;
+	Points[PointCount].Velocity = velocity;
+	PointCount++;
+	return true;
+}
+
+int MotionStreamer::Load(const Profile &profile)
+{
+	const double pointDt = kPointMs / 1000.0;
+	double position = 0.0;
+	PointCount = 0;
+	for(uint i = 0; i < profile.GetStepCount(); i++)
+	{
+		const ProfileParams &step = profile.GetStep(i);
+		switch(step.Command)
+		{
+			case kProfileMove:
+			{
+				//negative speeds drive forward, the points are feet forward
+				const MoveParams &mp = step.Move;
+				const TrajectorySample *samples = profile.GetTrajectory(mp);
+				double sign = mp.MaxSpeed < 0 ? 1.0 : -1.0;
+				double duration = samples[mp.TrajCount-1].Time;
+				int count = int(ceil(duration / pointDt));
+				for(int k = 1; k <= count; k++)
+				{
+					TrajectorySample sample = LookupTrajectory(samples,mp.TrajCount,mp.TrajDt,fmin(k * pointDt,duration));
+					if(!AddPoint(position + sign * sample.Position,sign * sample.Velocity)) return -1;
+				}
+				position += sign * samples[mp.TrajCount-1].Position;
+				break;
+			}
+			case kProfilePause:
+			{
+				int count = int(ceil(step.Pause.PauseTime / kPointMs));
+				for(int k = 0; k < count; k++)
+					if(!AddPoint(position,0.0)) return -1;
+				break;
+			}
+			default:
+				//needs the heading, stays with the drive loop
+				PointCount = 0;
+				return -1;
+		}
+	}
+	return PointCount > 0 ? PointCount : -1;
+}
+
+void MotionStreamer::Start(int leftCount, int rightCount)
+{
+	LeftStart = leftCount;
+	RightStart = rightCount;
+	Run.store(true,std::memory_order_relaxed);
+	Generation.fetch_add(1,std::memory_order_release);
+}
+
+void MotionStreamer::Stop()
+{
+	Run.store(false,std::memory_order_relaxed);
+	Generation.fetch_add(1,std::memory_order_release);
+}
+
+void MotionStreamer::GetTalonGains(const Profile &profile, double feetPerPulse, double *kP, double *kF)
+{
+	*kP = profile.ProfileMoveKp * feetPerPulse * 1023.0;
+	*kF = 1023.0 * feetPerPulse * 10.0 / profile.ProfileMaxVelocity;
+}
+
+MotionPoint MotionStreamer::ToPoint(int index, int startCount, double direction)
+{
+	MotionPoint point;
+	point.Position = startCount + direction * Points[index].Position / FeetPerPulse;
+	point.Velocity = direction * Points[index].Velocity / FeetPerPulse / 10.0;
+	point.DurationMs = kPointMs;
+	point.IsLast = index == PointCount - 1;
+	return point;
+}
+
+void MotionStreamer::Service()
+{
+	uint32_t generation = Generation.load(std::memory_order_acquire);
+	if(generation != FillGeneration)
+	{
+		//new Start or a Stop, take the Talons out of the old profile first
+		//(a finished one is already disabled, the 50Hz loop may be driving them again)
+		FillGeneration = generation;
+		FillLeftStart = LeftStart;
+		FillRightStart = RightStart;
+		if(Enabled && !Done)
+		{
+			Left->SetMode(kMotionDisable);
+			Right->SetMode(kMotionDisable);
+		}
+		Left->Clear();
+		Right->Clear();
+		Left->ClearUnderrun();
+		Right->ClearUnderrun();
+		Pushed = 0;
+		Enabled = false;
+		Done = false;
+		Acked.store(generation,std::memory_order_release);
+	}
+	if(!Run.load(std::memory_order_relaxed) || Done) return;
+
+	MotionBufferStatus left, right;
+	Left->GetStatus(&left);
+	Right->GetStatus(&right);
+	int room = left.TopBufferRem < right.TopBufferRem ? left.TopBufferRem : right.TopBufferRem;
+	for(; room > 0 && Pushed < PointCount; room--, Pushed++)
+	{
+		Left->PushPoint(ToPoint(Pushed,FillLeftStart,LeftDirection));
+		Right->PushPoint(ToPoint(Pushed,FillRightStart,RightDirection));
+	}
+	Left->ProcessBuffer();
+	Right->ProcessBuffer();
+	Left->GetStatus(&left);
+	Right->GetStatus(&right);
+
+	if(!Enabled)
+	{
+		int primed = left.BtmBufferCnt < right.BtmBufferCnt ? left.BtmBufferCnt : right.BtmBufferCnt;
+		bool allDown = Pushed == PointCount && left.TopBufferCnt == 0 && right.TopBufferCnt == 0;
+		if(primed < kPrimePoints && !allDown) return;
+		Left->SetMode(kMotionEnable);
+		Right->SetMode(kMotionEnable);
+		Enabled = true;
+		StartTime = StreamClock->GetFPGATime();
+		Logger::Write(kLogStreamStart,PointCount,primed);
+		return;
+	}
+	if(left.HasUnderrun || right.HasUnderrun)
+	{
+		uint32_t underruns = Underruns.fetch_add(1,std::memory_order_relaxed) + 1;
+		int waiting = left.TopBufferCnt + left.BtmBufferCnt;
+		Logger::Write(kLogStreamUnderrun,Pushed - waiting,left.BtmBufferCnt,right.BtmBufferCnt,underruns);
+		Left->ClearUnderrun();
+		Right->ClearUnderrun();
+	}
+	if(left.IsLast && right.IsLast)
+	{
+		//at the end of the trajectory, the brakes hold the robot
+		Left->SetMode(kMotionDisable);
+		Right->SetMode(kMotionDisable);
+		Done = true;
+		Finished.store(generation,std::memory_order_release);
+		Logger::Write(kLogStreamDone,PointCount,(StreamClock->GetFPGATime() - StartTime) / 1000,Underruns.load());
+	}
+}
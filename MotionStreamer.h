@@ -0,0 +1,105 @@
+/*
+ * MotionStreamer.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Hands a Profile's straight line moves to the drive Talons' motion profile
+ *  executers, so the trajectory runs on the motor controllers' own 1ms loop
+ *  instead of being re-sent as percent output every RIO cycle.
+ *
+ *  Load samples the trajectory tables of the loaded Profile into position and
+ *  velocity points in feet forward (MOVE and PAUSE steps only, the Talons have
+ *  no heading so TURN, CURVE and SPLINE stay with the DriveLoop).  After Start
+ *  the fill side, Service, runs on its own thread (a Notifier on the roboRIO)
+ *  at twice the point rate or faster: it keeps the top buffers topped up,
+ *  moves points down to the Talons, enables them once they are kPrimePoints
+ *  ahead, counts and logs underruns, and disables the Talons after the last
+ *  point.
+ *
+ *  The 50Hz side and the fill thread only share the atomics below.  The points
+ *  belong to the fill thread from Start until Stop, Load must not be called
+ *  in between.
+ *
+ */
+
+#ifndef SRC_MOTIONSTREAMER_H_
+#define SRC_MOTIONSTREAMER_H_
+
+#include "MotionProfileBuffer.h"
+#include "Profile.h"
+#include <atomic>
+
+class MotionStreamer
+{
+public:
+	static const int kMaxPoints = 2048;		//20 seconds of 10ms points
+	static const int kPointMs = 10;
+	static const int kPrimePoints = 10;		//points in the Talons before they are enabled
+private:
+	struct StreamPoint
+	{
+		float Position;			//feet from the start, positive forward
+		float Velocity;			//ft/s
+	};
+	Clock *StreamClock;
+	MotionProfileBuffer *Left;
+	MotionProfileBuffer *Right;
+	double FeetPerPulse;
+	double LeftDirection = 1.0;		//+1 or -1, which way the side's Talon counts driving forward
+	double RightDirection = 1.0;
+	StreamPoint Points[kMaxPoints];
+	int PointCount = 0;
+	//50Hz side, read by the fill thread after it sees a new generation
+	int LeftStart = 0;
+	int RightStart = 0;
+	std::atomic<uint32_t> Generation;		//changes for every Start and Stop
+	std::atomic<bool> Run;
+	std::atomic<uint32_t> Finished;			//generation whose last point has run
+	std::atomic<uint32_t> Acked;			//generation the fill thread has switched to
+	std::atomic<uint32_t> Underruns;
+	//fill thread side
+	uint32_t FillGeneration = 0;
+	int FillLeftStart = 0;
+	int FillRightStart = 0;
+	int Pushed = 0;
+	bool Enabled = false;
+	bool Done = false;
+	uint64_t StartTime = 0;
+
+	//Talon point for Points[index] from one side's start count and direction
+	MotionPoint ToPoint(int index, int startCount, double direction);
+	//append a point, false when the table is full
+	bool AddPoint(double position, double velocity);
+public:
+	//clock times the fill thread's log records
+	MotionStreamer(Clock *clock, MotionProfileBuffer *left, MotionProfileBuffer *right, double feetPerPulse);
+	//which way each Talon's position counts driving forward (Robot::kLeftEncoderSign),
+	//the sides are wired opposite so this sets the sign of each side's output
+	void SetDirections(double left, double right) { LeftDirection = left; RightDirection = right; }
+
+	//********* 50Hz LOOP **********
+	//sample the loaded profile into points, returns the point count or -1 if it can't be streamed
+	int Load(const Profile &profile);
+	//stream the loaded points from the encoder counts at the start
+	void Start(int leftCount, int rightCount);
+	//disable the Talons and drop the points
+	void Stop();
+	//true from Start until Stop
+	bool IsActive() const { return Run; }
+	//the fill thread has seen the last Stop and let go of the points
+	bool IsStopped() const { return !Run && Acked == Generation; }
+	//the Talons have run the last point of the last Start
+	bool IsFinished() const { return Run && Finished == Generation; }
+	//underruns since power up
+	uint32_t GetUnderruns() const { return Underruns; }
+
+	//Talon slot 0 gains that match the profile's MOVE loop, full output at
+	//ProfileMaxVelocity and ProfileMoveKp of output per foot behind
+	static void GetTalonGains(const Profile &profile, double feetPerPulse, double *kP, double *kF);
+
+	//********* FILL THREAD **********
+	//call every kPointMs / 2 or faster
+	void Service();
+};
+
+#endif /* SRC_MOTIONSTREAMER_H_ */
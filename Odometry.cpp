@@ -0,0 +1,41 @@
+/*
+ * Odometry.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Odometry.h"
+#include <math.h>
+
+Odometry::Odometry(double feetPerPulse)
+{
+	FeetPerPulse = feetPerPulse;
+}
+
+void Odometry::Reset(const Pose2d &pose, int leftCount, int rightCount, double heading)
+{
+	OdometryPose = pose;
+	LastLeftCount = leftCount;
+	LastRightCount = rightCount;
+	LastHeading = heading;
+	CenterDistance = 0.0;
+}
+
+void Odometry::Update(int leftCount, int rightCount, double heading)
+{
+	double left = (leftCount - LastLeftCount) * LeftEncoderSign * FeetPerPulse;
+	double right = (rightCount - LastRightCount) * RightEncoderSign * FeetPerPulse;
+	double center = (left + right) / 2;
+	//shortest way around, the gyro heading wraps at 360
+	double turn = remainder(heading - LastHeading,360.0);
+	double meanHeading = (OdometryPose.Heading + turn / 2) * M_PI / 180;
+
+	OdometryPose.X += center * cos(meanHeading);
+	OdometryPose.Y += center * sin(meanHeading);
+	OdometryPose.Heading += turn;	//unwrapped so the follower sees continuous heading
+	CenterDistance += center;
+
+	LastLeftCount = leftCount;
+	LastRightCount = rightCount;
+	LastHeading = heading;
+}
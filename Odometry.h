@@ -0,0 +1,42 @@
+/*
+ * Odometry.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Field relative pose from both drive encoders and the navX yaw.  The
+ *  encoders give the distance travelled by the center of the robot and the
+ *  gyro gives the heading (it does not slip like the wheels do).  Each update
+ *  integrates one cycle along the mean heading, no allocation.
+ *
+ */
+
+#ifndef SRC_ODOMETRY_H_
+#define SRC_ODOMETRY_H_
+
+#include "Pose.h"
+
+class Odometry
+{
+private:
+	Pose2d OdometryPose;
+	double FeetPerPulse;
+	int LastLeftCount = 0;
+	int LastRightCount = 0;
+	double LastHeading = 0.0;
+	double CenterDistance = 0.0;
+public:
+	//+1 or -1 so both sides count up driving forward (Robot::kLeftEncoderSign)
+	double LeftEncoderSign = 1.0;
+	double RightEncoderSign = 1.0;
+
+	Odometry(double feetPerPulse);
+	//start from pose with the current encoder counts and heading (degrees clockwise)
+	void Reset(const Pose2d &pose, int leftCount, int rightCount, double heading);
+	//call once per cycle with the raw encoder counts and heading (degrees clockwise)
+	void Update(int leftCount, int rightCount, double heading);
+	const Pose2d &GetPose() const { return OdometryPose; }
+	//feet travelled by the center of the robot since Reset, negative backing up
+	double GetDistance() const { return CenterDistance; }
+};
+
+#endif /* SRC_ODOMETRY_H_ */
@@ -3,33 +3,153 @@
  *
  *  Created on: Oct 15, 2016
  *      Author: chesterm
+ *
+ *  PID loop timed from the FPGA clock, so a late or early cycle does not change
+ *  the response.  Ki is per unit of error per second and Kd is per unit of error
+ *  change per second.  The integral term is clamped and is backed off while the
+ *  output is saturated, and the derivative goes through a first order low pass.
+ *
+ *  Gains come from a policy class.  RuntimeGains holds them by value for loops
+ *  tuned on the robot, FixedGains<T> reads T::kP, T::kI and T::kD (static
+ *  constexpr double) so they are folded into the update at compile time.
  */
 
 #ifndef PID_H_
 #define PID_H_
 
-class PID {
+#include <stdint.h>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+class RuntimeGains {
+ public:
+  RuntimeGains(double kP = 0.0, double kI = 0.0, double kD = 0.0) : kP_(kP), kI_(kI), kD_(kD) {}
+  void SetGains(double kP, double kI, double kD) {
+    kP_ = kP;
+    kI_ = kI;
+    kD_ = kD;
+  }
+  double P() const { return kP_; }
+  double I() const { return kI_; }
+  double D() const { return kD_; }
+
+ private:
+  double kP_;
+  double kI_;
+  double kD_;
+};
+
+template <typename Gains>
+class FixedGains {
+ public:
+  static constexpr double P() { return Gains::kP; }
+  static constexpr double I() { return Gains::kI; }
+  static constexpr double D() { return Gains::kD; }
+};
+
+template <typename GainPolicy = RuntimeGains>
+class PIDController : public GainPolicy {
+  // True for a single PIDController argument, which must go to the copy or move constructor
+  template <typename... Args>
+  struct IsController : std::false_type {};
+  template <typename Arg>
+  struct IsController<Arg> : std::is_base_of<PIDController, typename std::decay<Arg>::type> {};
+
  public:
-   PID(double* kP = 0, double* kI = 0, double* kD = 0);
+  // Arguments go to the gain policy, e.g. PID pid(kP, kI, kD)
+  template <typename... Args, typename = typename std::enable_if<!IsController<Args...>::value>::type>
+  explicit PIDController(Args&&... args) : GainPolicy(std::forward<Args>(args)...) {
+    Reset();
+  }
+  PIDController(const PIDController&) = default;
+  PIDController(PIDController&&) = default;
+  PIDController& operator=(const PIDController&) = default;
+  PIDController& operator=(PIDController&&) = default;
+
+  // Limits of the returned output, unlimited by default
+  void SetOutputRange(double min, double max) {
+    outMin_ = min;
+    outMax_ = max;
+  }
+  // Limits of the integral term, unlimited by default
+  void SetIntegralRange(double min, double max) {
+    iMin_ = min;
+    iMax_ = max;
+  }
+  // Time constant in seconds of the derivative low pass, 0 = unfiltered
+  void SetDerivativeFilter(double seconds) { filter_ = seconds; }
+  // Time in seconds for the integral to give back the output cut off by the range
+  void SetWindupTime(double seconds) { windupTime_ = seconds; }
+
   /**
-   * Resets the error counts. Call when the PID loop is not active to prevent integral windup.
+   * Resets the error counts and the time of the last update. Call when the PID loop
+   * starts so the first update only has a P term.
    */
-  void Initialize(double* kP, double* kI, double* kD);
-  void ResetError();
+  void Reset() {
+    lastTime_ = 0;
+    started_ = false;
+    lastError_ = 0.0;
+    dFiltered_ = 0.0;
+    p_ = 0.0;
+    i_ = 0.0;
+    d_ = 0.0;
+  }
 
-  double Update(double goal, double currentValue);
-  double TurnUpdate(double goal, double currentValue);
+  // time is the FPGA time of the measurement in microseconds
+  double Update(double goal, double currentValue, uint64_t time) {
+    double error = goal - currentValue;
+    double dt = started_ ? (time - lastTime_) / 1000000.0 : 0.0;
+    lastTime_ = time;
+    started_ = true;
+    if (dt > 0.0) {
+      double alpha = dt / (filter_ + dt);
+      dFiltered_ += alpha * ((error - lastError_) / dt - dFiltered_);
+      i_ = Limit(i_ + this->I() * error * dt, iMin_, iMax_);
+    }
+    lastError_ = error;
+    p_ = this->P() * error;
+    d_ = this->D() * dFiltered_;
+    double output = p_ + i_ + d_;
+    double limited = Limit(output, outMin_, outMax_);
+    // back calculation anti-windup, bleed off what the output range cut
+    if (this->I() != 0.0 && dt > 0.0)
+      i_ += (limited - output) * (dt < windupTime_ ? dt / windupTime_ : 1.0);
+    return limited;
+  }
+
+  // Terms of the last Update, for telemetry
+  double GetP() const { return p_; }
+  double GetI() const { return i_; }
+  double GetD() const { return d_; }
 
  private:
-  double* kP_;
-  double* kI_;
-  double* kD_;
+  static double Limit(double value, double min, double max) {
+    if (value > max) return max;
+    if (value < min) return min;
+    return value;
+  }
+
+  double outMin_ = -std::numeric_limits<double>::infinity();
+  double outMax_ = std::numeric_limits<double>::infinity();
+  double iMin_ = -std::numeric_limits<double>::infinity();
+  double iMax_ = std::numeric_limits<double>::infinity();
+  double filter_ = 0.0;
+  double windupTime_ = 0.1;
 
-  // Cumulative error used in integral term
-  double errorSum_;
+  uint64_t lastTime_;
+  bool started_;
 
   // Last error value used to find error difference for derivative term
   double lastError_;
+  double dFiltered_;
+
+  double p_;
+  double i_;
+  double d_;
 };
 
+// the run time tuned loop used by Profile
+typedef PIDController<RuntimeGains> PID;
+
 #endif
@@ -0,0 +1,21 @@
+/*
+ * Pose.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Field relative robot pose.  X feet forward from the starting position,
+ *  Y feet to the right, Heading degrees clockwise (same sense as the navX).
+ *
+ */
+
+#ifndef SRC_POSE_H_
+#define SRC_POSE_H_
+
+struct Pose2d
+{
+	double X = 0.0;
+	double Y = 0.0;
+	double Heading = 0.0;
+};
+
+#endif /* SRC_POSE_H_ */
@@ -1,15 +1,26 @@
 #include "Profile.h"
 #include "PID.h"
-#include "Utility.h"
+#include "Logger.h"
 #include <math.h>
-#include <vector>
-using namespace frc;
+#include <stdio.h>
+#include <memory>
 
-Profile::Profile()
+Profile::Profile(Clock *clock, uint trajPoolSize, uint pathPoolSize)
 {
+	ProfileClock = clock;
+	TrajPoolSize = trajPoolSize;
+	TrajPool = new TrajectorySample[trajPoolSize];
+	PathPoolSize = pathPoolSize;
+	PathPool = new PathSample[pathPoolSize];
 	Initialize();
 }
 
+Profile::~Profile()
+{
+	delete[] TrajPool;
+	delete[] PathPool;
+}
+
 void Profile::Initialize()
 {
 	try
@@ -21,10 +32,20 @@ void Profile::Initialize()
 		ProfileStep = StepNDX;
 		StartDistance = 0;
 		MoveStartHeading = 0;
+		TurnStartError = 0;
 		OutputMagnitude = 0;
 		Curve = 0;
-		TurnPID.Initialize(&ProfileTurnKp,&ProfileTurnKi,&ProfileTurnKd);
-		SteerPID.Initialize(&ProfileSteerKp,&ProfileSteerKi,&ProfileSteerKd);
+		ProfilePose = Pose2d();
+		PoseLastDistance = 0;
+		TurnPID.SetGains(fabs(ProfileTurnKp),fabs(ProfileTurnKi),fabs(ProfileTurnKd));
+		TurnPID.SetOutputRange(-1.0,1.0);
+		TurnPID.SetIntegralRange(-1.0,1.0);
+		TurnPID.SetDerivativeFilter(ProfileDerivativeFilter);
+		TurnPID.Reset();
+		StartSteer(1.0);
+		SteerPID.SetOutputRange(-1.0,1.0);
+		SteerPID.SetIntegralRange(-1.0,1.0);
+		SteerPID.SetDerivativeFilter(ProfileDerivativeFilter);
 	}
 	catch(std::exception& ex)
 	{
@@ -34,52 +55,157 @@ void Profile::Initialize()
 	}
 }
 
+void Profile::Restart()
+{
+	bool loaded = ProfileLoaded;
+	Initialize();
+	ProfileLoaded = loaded;
+	for(uint i = 0; i < StepCount; i++)
+	{
+		Steps[i].StartFlag = false;
+		Steps[i].DoneFlag = false;
+	}
+}
+
+//gains that can be tuned offline and loaded from a file
+static const struct
+{
+	const char *Name;
+	double Profile::*Gain;
+} ProfileGains[] =
+{
+	{"ProfileSteerKp",&Profile::ProfileSteerKp},
+	{"ProfileSteerKi",&Profile::ProfileSteerKi},
+	{"ProfileSteerKd",&Profile::ProfileSteerKd},
+	{"ProfileTurnKp",&Profile::ProfileTurnKp},
+	{"ProfileTurnKi",&Profile::ProfileTurnKi},
+	{"ProfileTurnKd",&Profile::ProfileTurnKd},
+	{"ProfileMoveKp",&Profile::ProfileMoveKp},
+};
+
+int Profile::LoadGains(const char *path)
+{
+	int count = 0;
+	try
+	{
+		std::ifstream file(path);
+		if(!file.is_open())
+		{
+			printf("[Profile_LoadGains] %s not found, using default gains\n",path);
+			return -1;
+		}
+		std::string line;
+		while(std::getline(file,line))
+		{
+			line = line.substr(0,line.find('#'));
+			size_t equals = line.find('=');
+			if(equals == std::string::npos) continue;
+			std::istringstream name(line.substr(0,equals));
+			std::istringstream value(line.substr(equals + 1));
+			std::string key;
+			double gain;
+			if(!(name >> key) || !(value >> gain))
+			{
+				printf("[Profile_LoadGains] bad line: %s\n",line.c_str());
+				continue;
+			}
+			bool found = false;
+			for(const auto &entry : ProfileGains)
+			{
+				if(key != entry.Name) continue;
+				this->*entry.Gain = gain;
+				found = true;
+				count++;
+			}
+			if(!found) printf("[Profile_LoadGains] unknown gain %s\n",key.c_str());
+		}
+		printf("[Profile_LoadGains] %i gains loaded from %s\n",count,path);
+	}
+	catch(std::exception& ex)
+	{
+		std::string err_string = "[Profile_LoadGains] ";
+		err_string += ex.what();
+		printf(err_string.c_str());
+	}
+	return count;
+}
+
+int Profile::SaveGains(const char *path)
+{
+	try
+	{
+		std::ofstream file(path);
+		if(!file.is_open()) return -1;
+		char line[64];
+		for(const auto &entry : ProfileGains)
+		{
+			snprintf(line,sizeof(line),"%s = %.6g\n",entry.Name,this->*entry.Gain);
+			file << line;
+		}
+		return file.good() ? 0 : -1;
+	}
+	catch(std::exception& ex)
+	{
+		std::string err_string = "[Profile_SaveGains] ";
+		err_string += ex.what();
+		printf(err_string.c_str());
+	}
+	return -1;
+}
+
 void Profile::ExecuteProfile(double heading, double distance)
+{
+	//dead reckon along the mean heading of the cycle, distance is the right side
+	//of the drive so add back half the track for the heading change to get the center
+	Pose2d pose = ProfilePose;
+	double turn = remainder(heading - ProfilePose.Heading,360.0);
+	double delta = distance - PoseLastDistance + turn * M_PI / 180 * ProfileTrackWidth / 2;
+	double meanHeading = (ProfilePose.Heading + turn / 2) * M_PI / 180;
+	PoseLastDistance = distance;
+	pose.X += delta * cos(meanHeading);
+	pose.Y += delta * sin(meanHeading);
+	pose.Heading = ProfilePose.Heading + turn;
+	ExecuteProfile(heading,distance,pose);
+}
+
+void Profile::ExecuteProfile(double heading, double distance, const Pose2d &pose)
 {
 	double curDistance = 0;
-	static double startError = 0;
 	double curError = 0;
 
+	ProfilePose = pose;
 	try
 	{
-		if(Steps.size() > 0)
+		if(StepCount > 0)
 		{
 			curDistance = distance - StartDistance;
-			switch((int)Steps[StepNDX].Command) //evaluate command
+			switch(Steps[StepNDX].Command) //evaluate command
 			{
 				//MOVE - drive straight for given distance
 				// 1 = Direction
 				// 2 = Distance in feet
-				case 1:
+				case kProfileMove:
 				{
 					if(!Steps[StepNDX].StartFlag) //Start Flag
 					{
 						Steps[StepNDX].StartFlag = true;
 						StartDistance = distance;
 						curDistance = distance - StartDistance;
-						//reverse the steering gain depending on forward or reverse
-						if (Steps[StepNDX].MaxSpeed < 0) ProfileSteerKp = fabs(ProfileSteerKp) * -1;
-						else ProfileSteerKp = fabs(ProfileSteerKp);
-						if (StepNDX > 0)
-							Set_Trapezoid(Steps[StepNDX].TgtDistance,Steps[StepNDX].MinSpeed,Steps[StepNDX].MaxSpeed,Steps[StepNDX-1].MaxSpeed,Steps[StepNDX+1].MaxSpeed); //initialize the move profile
-						else
-							Set_Trapezoid(Steps[StepNDX].TgtDistance,Steps[StepNDX].MinSpeed,Steps[StepNDX].MaxSpeed,0,Steps[StepNDX+1].MaxSpeed); //initialize the move profile
+						StartSteer(Steps[StepNDX].Move.MaxSpeed);
+						Set_Trajectory(); //initialize the move profile
 						MoveStartHeading = heading;
-						printf("MOVE %i Start -  Tgt: %5.2f\n",StepNDX,Steps[StepNDX].TgtDistance);
-						printf("MOVE %i Start - Dist: %5.2f\n",StepNDX,curDistance);
-						printf("MOVE %i StartHeading: %5.2f\n",StepNDX,MoveStartHeading);
+						Logger::Write(kLogMoveStart,StepNDX,Steps[StepNDX].Move.TgtDistance,curDistance,MoveStartHeading);
 					}
 					if(!Steps[StepNDX].DoneFlag)
 					{
 						curError = GetNormalizedError(heading,MoveStartHeading);
-						Curve = Clamp(SteerPID.Update(0.0,curError));
-						OutputMagnitude = Clamp(Get_Trapezoid(curDistance)); //execute the move profile
+						Curve = SteerPID.Update(0.0,curError,ProfileClock->GetFPGATime());
+						OutputMagnitude = Clamp(Get_Trajectory(curDistance)); //execute the move profile
 						//printf("[ExecuteProfile] dist= %.1f speed=%.2f  curve%.1f\n",curDistance,OutputMagnitude,Curve);
 					}
 					else
 					{
-						printf("MOVE %i Done - Dist: %5.2f\n",StepNDX,curDistance);
-						printf("MOVE %i EndHeading: %5.2f\n",StepNDX,heading);
+						Logger::Write(kLogMoveDone,StepNDX,curDistance,heading);
 						Curve = 0.0;
 						OutputMagnitude = 0.0;
 						StepNDX++;
@@ -89,27 +215,26 @@ void Profile::ExecuteProfile(double heading, double distance)
 				//TURN - turn to new heading
 				// 1 = Heading
 				// 2 = Speed
-				case 2:
+				case kProfileTurn:
 				{
 					if(!Steps[StepNDX].StartFlag) //Start Flag
 					{
 						Steps[StepNDX].StartFlag = true;
-						printf("TURN %i Start -   Tgt: %5.2f\n",StepNDX,Steps[StepNDX].TgtHeading);
-						printf("TURN %i Start - Angle: %5.2f\n",StepNDX,heading);
-						startError = GetNormalizedError(heading,Steps[StepNDX].TgtHeading);
-						printf("TURN %i Start - Error: %5.2f\n",StepNDX,startError);
-						ProfileTurnKp = fabs(ProfileTurnKp);
+						TurnStartError = GetNormalizedError(heading,Steps[StepNDX].Turn.TgtHeading);
+						Logger::Write(kLogTurnStart,StepNDX,Steps[StepNDX].Turn.TgtHeading,heading,TurnStartError);
+						TurnPID.SetGains(fabs(ProfileTurnKp),fabs(ProfileTurnKi),fabs(ProfileTurnKd));
+						TurnPID.Reset();
 					}
 					if(!Steps[StepNDX].DoneFlag)
 					{
-						curError = GetNormalizedError(heading,Steps[StepNDX].TgtHeading);
-						Curve = Clamp(TurnPID.Update(0.0,curError));
+						curError = GetNormalizedError(heading,Steps[StepNDX].Turn.TgtHeading);
+						Curve = TurnPID.Update(0.0,curError,ProfileClock->GetFPGATime());
 						//Set curve based on which way we are turning - left = negative
-						if (Steps[StepNDX].TurnSpeed < 0) Curve = fabs(Curve) * -1.0;
+						if (Steps[StepNDX].Turn.TurnSpeed < 0) Curve = fabs(Curve) * -1.0;
 						else Curve = fabs(Curve);
 						//calculate ramp for turning speed
-						double speedfactor = curError/startError;
-						double ramp = Steps[StepNDX].TurnSpeed * speedfactor;
+						double speedfactor = curError/TurnStartError;
+						double ramp = Steps[StepNDX].Turn.TurnSpeed * speedfactor;
 						if(ramp < 0 && ramp > -0.25) ramp = -0.25;
 						if(ramp > 0 && ramp < 0.25)	ramp = 0.25;
 						//set speed of outside wheel in turn
@@ -119,8 +244,7 @@ void Profile::ExecuteProfile(double heading, double distance)
 					}
 					else
 					{
-						printf("TURN %i Done - Angle: %5.2f\n",StepNDX,heading);
-						printf("TURN %i Done - Error: %5.2f\n",StepNDX,curError);
+						Logger::Write(kLogTurnDone,StepNDX,heading,curError);
 						Curve = 0.0;
 						OutputMagnitude = 0.0;
 						StepNDX++;
@@ -129,18 +253,17 @@ void Profile::ExecuteProfile(double heading, double distance)
 				}
 				//PAUSE - wait for a period of time
 				// 1 = pause time in milliseconds
-				case 3:
+				case kProfilePause:
 				{
 					if(!Steps[StepNDX].StartFlag) //Start Flag
 					{
 						Steps[StepNDX].StartFlag = true;
-						PauseTime = RobotController::GetFPGATime();
-						printf("PAUSE - Start\n");
-						printf("PAUSE - Duration: %ju\n",uint64_t(Steps[StepNDX].PauseTime));
+						PauseTime = ProfileClock->GetFPGATime();
+						Logger::Write(kLogPauseStart,StepNDX,Steps[StepNDX].Pause.PauseTime);
 					}
-					ElapsedTime = RobotController::GetFPGATime();
+					ElapsedTime = ProfileClock->GetFPGATime();
 					ElapsedTime = (ElapsedTime - PauseTime) / 1000;
-					if(ElapsedTime < uint64_t(Steps[StepNDX].PauseTime))
+					if(ElapsedTime < uint64_t(Steps[StepNDX].Pause.PauseTime))
 					{
 						Curve = 0.0;
 						OutputMagnitude = 0.0;
@@ -148,8 +271,7 @@ void Profile::ExecuteProfile(double heading, double distance)
 					else
 					{
 						Steps[StepNDX].DoneFlag = true; //Done Flag
-						printf("PAUSE - Done\n");
-						printf("PAUSE - Elapsed %ju\n",ElapsedTime);
+						Logger::Write(kLogPauseDone,StepNDX,ElapsedTime);
 						Curve = 0.0;
 						OutputMagnitude = 0.0;
 						StepNDX++;
@@ -161,36 +283,56 @@ void Profile::ExecuteProfile(double heading, double distance)
 				// 1 = Direction
 				// 3 = Distance in feet
 				// 4 = Curve    (-1 to 1 with -1 to left, +1 to right)
-				case 4:
+				case kProfileCurve:
 				{
 					if(!Steps[StepNDX].StartFlag) //Start Flag
 					{
 						Steps[StepNDX].StartFlag = true;
 						StartDistance = distance;
 						curDistance = distance - StartDistance;
-						//reverse the steering gain depending on forward or reverse
-						if (Steps[StepNDX].MaxSpeed < 0) ProfileSteerKp = fabs(ProfileSteerKp) * -1;
-						else ProfileSteerKp = fabs(ProfileSteerKp);
-						if (StepNDX > 0)
-							Set_Trapezoid(Steps[StepNDX].TgtDistance,Steps[StepNDX].MinSpeed,Steps[StepNDX].MaxSpeed,Steps[StepNDX-1].MaxSpeed,Steps[StepNDX+1].MaxSpeed); //initialize the move profile
-						else
-							Set_Trapezoid(Steps[StepNDX].TgtDistance,Steps[StepNDX].MinSpeed,Steps[StepNDX].MaxSpeed,0,Steps[StepNDX+1].MaxSpeed); //initialize the move profile
+						Set_Trajectory(); //initialize the move profile
 						MoveStartHeading = heading;
-						printf("CURVE %i Start -  Tgt: %5.2f\n",StepNDX,Steps[StepNDX].TgtDistance);
-						printf("CURVE %i Start - Dist: %5.2f\n",StepNDX,curDistance);
-						printf("CURVE %i StartHeading: %5.2f\n",StepNDX,MoveStartHeading);
+						Logger::Write(kLogCurveStart,StepNDX,Steps[StepNDX].Move.TgtDistance,curDistance,MoveStartHeading);
 					}
 					if(!Steps[StepNDX].DoneFlag)
 					{
 						//curError = GetNormalizedError(heading,MoveStartHeading);
 						//Curve = Clamp(SteerPID.Update(0.0,curError));
-						Curve = Clamp(Steps[StepNDX].Curve); //user controls amount of curve, 0 = straight
-						OutputMagnitude = Clamp(Get_Trapezoid(curDistance)); //execute the move profile
+						Curve = Clamp(Steps[StepNDX].Move.Curve); //user controls amount of curve, 0 = straight
+						OutputMagnitude = Clamp(Get_Trajectory(curDistance)); //execute the move profile
+					}
+					else
+					{
+						Logger::Write(kLogCurveDone,StepNDX,curDistance,heading);
+						Curve = 0.0;
+						OutputMagnitude = 0.0;
+						StepNDX++;
+					}
+					break;
+				}
+				//SPLINE - drive a quintic spline path through waypoints
+				// 3 = path length for the right wheels in feet
+				case kProfileSpline:
+				{
+					if(!Steps[StepNDX].StartFlag) //Start Flag
+					{
+						Steps[StepNDX].StartFlag = true;
+						StartDistance = distance;
+						curDistance = distance - StartDistance;
+						StartSteer(-1.0);	//always forward
+						Set_Trajectory(); //initialize the path
+						MoveStartHeading = heading;
+						PathOrigin = ProfilePose;
+						Logger::Write(kLogSplineStart,StepNDX,Steps[StepNDX].Move.TgtDistance,MoveStartHeading);
+					}
+					if(!Steps[StepNDX].DoneFlag)
+					{
+						if(ProfileFollower) OutputMagnitude = Clamp(Follow_Path()); //track the path, sets Curve
+						else OutputMagnitude = Clamp(Get_Path(heading,curDistance)); //execute the path, sets Curve
 					}
 					else
 					{
-						printf("CURVE %i Done - Dist: %5.2f\n",StepNDX,curDistance);
-						printf("CURVE %i EndHeading: %5.2f\n",StepNDX,heading);
+						Logger::Write(kLogSplineDone,StepNDX,curDistance,heading);
 						Curve = 0.0;
 						OutputMagnitude = 0.0;
 						StepNDX++;
@@ -210,8 +352,9 @@ void Profile::ExecuteProfile(double heading, double distance)
 			Curve = 0.0;
 			OutputMagnitude = 0.0;
 		}
+		if(ProfileTrace) Logger::Write(kLogProfileTrace,StepNDX,heading,curDistance,OutputMagnitude,Curve);
 		ProfileStep = StepNDX;
-		ProfileCompleted = StepNDX >= Steps.size();
+		ProfileCompleted = StepNDX >= StepCount;
 	}
 	catch(std::exception& ex)
 	{
@@ -234,7 +377,9 @@ int Profile::ClearProfile()
 		MoveStartHeading = 0;
 		OutputMagnitude = 0;
 		Curve = 0;
-		Steps.clear();
+		StepCount = 0;
+		TrajPoolUsed = 0;
+		PathPoolUsed = 0;
 		return 0;
 	}
 	catch(std::exception& ex)
@@ -248,49 +393,79 @@ int Profile::ClearProfile()
 
 int Profile::AddMove(DirectionType Direction, double TgtDistance)
 {
-	ProfileParams pp;
+	try
+	{
+		ProfileParams *pp = NewStep(kProfileMove);
+		if(pp == NULL) return 0;
+		SetMoveParams(pp->Move,Direction,TgtDistance);
+		return AddTrajectory();
+	}
+	catch(std::exception& ex)
+	{
+		std::string err_string = "[AddMove] ";
+		err_string += ex.what();
+		printf(err_string.c_str());
+		return 0.0f;
+	}
+}
+
+void Profile::SetMoveParams(MoveParams &mp, DirectionType Direction, double TgtDistance)
+{
+	if (Direction == kProfileForward)
+	{
+		mp.MinSpeed = fabs(ProfileMinSpeed) * -1;
+		mp.MaxSpeed = fabs(ProfileMaxSpeed) * -1;
+	}
+	else
+	{
+		mp.MinSpeed = fabs(ProfileMinSpeed);
+		mp.MaxSpeed = fabs(ProfileMaxSpeed);
+	}
+	mp.TgtDistance = TgtDistance;
+	mp.MaxAccel = ProfileMaxAccel;
+	mp.MaxJerk = ProfileMotion == kMotionSCurve ? ProfileMaxJerk : 0.0;
+}
 
+int Profile::AddTableMove(DirectionType Direction, double TgtDistance, const MotionLimits &limits,
+		const TrajectorySample *samples, int count, double dt)
+{
 	try
 	{
-		pp.Command = 1;
-		if (Direction == kProfileForward)
+		ProfileParams *pp = NewStep(kProfileMove);
+		if(pp == NULL) return 0;
+		SetMoveParams(pp->Move,Direction,TgtDistance);
+		//a continuous move carries speed across its ends, the table stops at both
+		if(ProfileContinuous || limits.StartVelocity != 0.0 || limits.EndVelocity != 0.0 ||
+				limits.MaxVelocity != fabs(pp->Move.MaxSpeed) * ProfileMaxVelocity ||
+				limits.MaxAccel != pp->Move.MaxAccel || limits.MaxJerk != pp->Move.MaxJerk ||
+				dt != ProfileTrajectoryDt)
 		{
-			pp.MinSpeed = fabs(ProfileMinSpeed) * -1;
-			pp.MaxSpeed = fabs(ProfileMaxSpeed) * -1;
+			Logger::Write(kLogTrajTableStale,StepCount-1);
+			return AddTrajectory();
 		}
-		else
-		{
-			pp.MinSpeed = fabs(ProfileMinSpeed);
-			pp.MaxSpeed = fabs(ProfileMaxSpeed);
-		}
-		pp.TgtDistance = TgtDistance;
-		pp.StartFlag = false;
-		pp.DoneFlag = false;
-		Steps.push_back(pp);
-		return Steps.size();
+		pp->Move.Table = samples;
+		pp->Move.TrajCount = count;
+		pp->Move.TrajDt = dt;
+		return StepCount;
 	}
 	catch(std::exception& ex)
 	{
-		std::string err_string = "[AddMove] ";
+		std::string err_string = "[AddTableMove] ";
 		err_string += ex.what();
 		printf(err_string.c_str());
-		return 0.0f;
+		return 0;
 	}
 }
 
 int Profile::AddTurn(double TgtHeading, double speed)
 {
-	ProfileParams pp;
-
 	try
 	{
-		pp.Command = 2;
-		pp.TgtHeading = TgtHeading;
-		pp.TurnSpeed = speed;
-		pp.StartFlag = false;
-		pp.DoneFlag = false;
-		Steps.push_back(pp);
-		return Steps.size();
+		ProfileParams *pp = NewStep(kProfileTurn);
+		if(pp == NULL) return 0;
+		pp->Turn.TgtHeading = TgtHeading;
+		pp->Turn.TurnSpeed = speed;
+		return StepCount;
 	}
 	catch(std::exception& ex)
 	{
@@ -303,16 +478,12 @@ int Profile::AddTurn(double TgtHeading, double speed)
 
 int Profile::AddPause(double mSecs)
 {
-	ProfileParams pp;
-
 	try
 	{
-		pp.Command = 3;
-		pp.PauseTime = mSecs;
-		pp.StartFlag = false;
-		pp.DoneFlag = false;
-		Steps.push_back(pp);
-		return Steps.size();
+		ProfileParams *pp = NewStep(kProfilePause);
+		if(pp == NULL) return 0;
+		pp->Pause.PauseTime = mSecs;
+		return StepCount;
 	}
 	catch(std::exception& ex)
 	{
@@ -325,27 +496,25 @@ int Profile::AddPause(double mSecs)
 
 int Profile::AddCurve(DirectionType Direction, double TgtDistance, double Curve)
 {
-	ProfileParams pp;
-
 	try
 	{
-		pp.Command = 4;
+		ProfileParams *pp = NewStep(kProfileCurve);
+		if(pp == NULL) return 0;
 		if (Direction == kProfileForward)
 		{
-			pp.MinSpeed = fabs(ProfileMinSpeed) * -1;
-			pp.MaxSpeed = fabs(ProfileMaxSpeed) * -1;
+			pp->Move.MinSpeed = fabs(ProfileMinSpeed) * -1;
+			pp->Move.MaxSpeed = fabs(ProfileMaxSpeed) * -1;
 		}
 		else
 		{
-			pp.MinSpeed = fabs(ProfileMinSpeed);
-			pp.MaxSpeed = fabs(ProfileMaxSpeed);
+			pp->Move.MinSpeed = fabs(ProfileMinSpeed);
+			pp->Move.MaxSpeed = fabs(ProfileMaxSpeed);
 		}
-		pp.TgtDistance = TgtDistance;
-		pp.Curve = Curve;
-		pp.StartFlag = false;
-		pp.DoneFlag = false;
-		Steps.push_back(pp);
-		return Steps.size();
+		pp->Move.TgtDistance = TgtDistance;
+		pp->Move.Curve = Curve;
+		pp->Move.MaxAccel = ProfileMaxAccel;
+		pp->Move.MaxJerk = ProfileMotion == kMotionSCurve ? ProfileMaxJerk : 0.0;
+		return AddTrajectory();
 	}
 	catch(std::exception& ex)
 	{
@@ -356,6 +525,42 @@ int Profile::AddCurve(DirectionType Direction, double TgtDistance, double Curve)
 	}
 }
 
+int Profile::AddSpline(const Waypoint *waypoints, int count)
+{
+	try
+	{
+		ProfileParams *pp = NewStep(kProfileSpline);
+		if(pp == NULL) return 0;
+		pp->Move.MinSpeed = fabs(ProfileMinSpeed) * -1;
+		pp->Move.MaxSpeed = fabs(ProfileMaxSpeed) * -1;
+		pp->Move.MaxAccel = ProfileMaxAccel;
+		PathLimits limits = GetPathLimits(ProfileMaxSpeed);
+		//scratch for building, one per thread that builds splines instead of one per profile
+		static thread_local std::unique_ptr<SplineGenerator> generator;
+		if(!generator) generator.reset(new SplineGenerator());
+		int samples = generator->Generate(waypoints,count,limits,ProfileTrajectoryDt,
+				&PathPool[PathPoolUsed],PathPoolSize - PathPoolUsed,&pp->Move.TrajDt);
+		if(samples == 0)
+		{
+			Logger::Write(kLogSplineFailed,StepCount - 1);
+			StepCount--;
+			return 0;
+		}
+		pp->Move.TrajStart = PathPoolUsed;
+		pp->Move.TrajCount = samples;
+		PathPoolUsed += samples;
+		pp->Move.TgtDistance = fabs(PathPool[pp->Move.TrajStart + samples - 1].WheelDistance);
+		return StepCount;
+	}
+	catch(std::exception& ex)
+	{
+		std::string err_string = "[AddSpline] ";
+		err_string += ex.what();
+		printf(err_string.c_str());
+		return 0.0f;
+	}
+}
+
 //Parameters are in 0-360 degrees
 double Profile::GetNormalizedError(double heading, double newHeading)
 {
@@ -382,113 +587,277 @@ double Profile::Clamp(double steerRate)
 	return steerClamp;
 }
 
-void Profile::Set_Trapezoid(double tgtValue, double minSpeed, double maxSpeed, double lastSpeed, double nextSpeed)
+//steering gains change sign with the drive direction, negative speed is forward
+void Profile::StartSteer(double speed)
+{
+	double sign = speed < 0 ? -1.0 : 1.0;
+	SteerPID.SetGains(sign * fabs(ProfileSteerKp),sign * fabs(ProfileSteerKi),sign * fabs(ProfileSteerKd));
+	SteerPID.Reset();
+}
+
+static bool IsTrajectoryStep(const ProfileParams &pp)
+{
+	return pp.Command == kProfileMove || pp.Command == kProfileCurve;
+}
+
+ProfileParams *Profile::NewStep(ProfileCommand command)
+{
+	if(StepCount >= kMaxSteps)
+	{
+		Logger::Write(kLogProfileFull,StepCount);
+		return NULL;
+	}
+	ProfileParams *pp = &Steps[StepCount++];
+	*pp = ProfileParams();
+	pp->Command = command;
+	return pp;
+}
+
+int Profile::BuildTrajectory(uint stepNDX)
+{
+	MoveParams &mp = Steps[stepNDX].Move;
+	MotionLimits limits;
+	limits.MaxVelocity = GetStepMaxVelocity(mp);
+	limits.MaxAccel = mp.MaxAccel;
+	limits.MaxJerk = mp.MaxJerk;
+	//in continuous mode carry speed into and out of neighbouring moves in the same direction
+	if(ProfileContinuous && stepNDX > 0)
+	{
+		const ProfileParams &last = Steps[stepNDX-1];
+		if(IsTrajectoryStep(last) && (last.Move.MaxSpeed < 0) == (mp.MaxSpeed < 0))
+			limits.StartVelocity = fmin(GetStepMaxVelocity(last.Move),limits.MaxVelocity);
+	}
+	if(ProfileContinuous && stepNDX + 1 < StepCount)
+	{
+		const ProfileParams &next = Steps[stepNDX+1];
+		if(IsTrajectoryStep(next) && (next.Move.MaxSpeed < 0) == (mp.MaxSpeed < 0))
+			limits.EndVelocity = fmin(GetStepMaxVelocity(next.Move),limits.MaxVelocity);
+	}
+	TrajectoryPlan plan = PlanTrajectory(mp.TgtDistance,limits);
+	int count = SampleTrajectory(plan,ProfileTrajectoryDt,&TrajPool[TrajPoolUsed],TrajPoolSize - TrajPoolUsed,&mp.TrajDt);
+	if(count == 0)
+	{
+		Logger::Write(kLogTrajPoolFull,stepNDX);
+		return 0;
+	}
+	mp.TrajStart = TrajPoolUsed;
+	mp.TrajCount = count;
+	TrajPoolUsed += count;
+	return count;
+}
+
+int Profile::AddTrajectory()
+{
+	uint stepNDX = StepCount - 1;
+	//the previous move's table is the last one in the pool, re-plan it to end at this step's speed
+	if(ProfileContinuous && stepNDX > 0 && IsTrajectoryStep(Steps[stepNDX-1]) && Steps[stepNDX-1].Move.Table == NULL)
+	{
+		TrajPoolUsed = Steps[stepNDX-1].Move.TrajStart;
+		BuildTrajectory(stepNDX-1);
+	}
+	if(BuildTrajectory(stepNDX) == 0)
+	{
+		StepCount--;
+		return 0;
+	}
+	return StepCount;
+}
+
+void Profile::Set_Trajectory()
 {
 	try
 	{
-		MoveTarget = abs(tgtValue);
-		MoveSteps = (MoveTarget/0.25) * 12;  // 1/4" slices with given distance in feet
-		MoveMinSpeed = minSpeed;
-		MoveMaxSpeed = maxSpeed;
-		MoveLastSpeed = lastSpeed;
-		MoveNextSpeed = nextSpeed;
-		MoveFirstCorner = MoveSteps/8;  //ramp = 1/8 of total distance
-		MoveSecondCorner = MoveFirstCorner * 7;
-		MoveSlice = MoveTarget/MoveSteps;
-		MoveAccel = (MoveMaxSpeed - MoveMinSpeed) / (MoveFirstCorner * MoveSlice);
-		MoveStartTime = RobotController::GetFPGATime();
+		MoveTarget = fabs(Steps[StepNDX].Move.TgtDistance);
+		MoveMinSpeed = Steps[StepNDX].Move.MinSpeed;
+		MoveMaxSpeed = Steps[StepNDX].Move.MaxSpeed;
+		MoveCruise = fabs(MoveMaxSpeed) * ProfileMaxVelocity;
+		MoveStartTime = ProfileClock->GetFPGATime();
 	}
 	catch(std::exception& ex)
 	{
-		std::string err_string = "[Set_Trapezoid] ";
+		std::string err_string = "[Set_Trajectory] ";
 		err_string += ex.what();
 		printf(err_string.c_str());
 	}
 }
 
-//This is a trapezoidal motion profile based on discrete distance steps
-double Profile::Get_Trapezoid(double curDist)
+//Follows the step's trajectory table by time since the step started.
+//Speed is scaled from MinSpeed (standing) to MaxSpeed (cruise) with a correction
+//for distance behind the trajectory; the step is done when the distance is reached.
+double Profile::Get_Trajectory(double curDist)
 {
 	double outSpeed = 0.0f;
-	double curStep = 0;
 
 	try
 	{
-		curStep = abs(round(abs(curDist)/MoveSlice));
-		if(curStep < MoveSteps)
+		double dist = fabs(curDist);
+		if(dist < MoveTarget)
 		{
-			if(curStep <= MoveFirstCorner)
-			{
-				outSpeed = (MoveAccel * abs(curDist)) + MoveMinSpeed;
-				if(ProfileContinuous && StepNDX > 0) //check for first step
-				{
-					if((int)Steps[StepNDX-1].Command != 3) //check for pause as last step
-						if (outSpeed <  MoveLastSpeed) outSpeed = MoveLastSpeed;
-				}
-				//make sure MoveMinSpeed is not too low for the robot to move
-				if(MoveDistCount < 5) MoveDistCount++;
-				else
-				{
-					MoveDistCount = 0;
-					//if we have not moved then bump speed by 10%
-					if(fabs(curDist) < MoveSlice)
-					{
-						if(MoveMinSpeed > 0)
-						{
-							MoveMinSpeed += (MoveMaxSpeed - MoveMinSpeed)/10;
-							if(MoveMinSpeed > MoveMaxSpeed) MoveMinSpeed = MoveMaxSpeed;
-						}
-						else
-						{
-							MoveMinSpeed -= (MoveMaxSpeed - MoveMinSpeed)/10;
-							if(MoveMinSpeed < MoveMaxSpeed) MoveMinSpeed = MoveMaxSpeed;
-						}
-					}
-
-				}
-			}
-			if(curStep > MoveFirstCorner && curStep < MoveSecondCorner) outSpeed = MoveMaxSpeed;
-			if(curStep >= MoveSecondCorner)
-			{
-				outSpeed = (MoveAccel * (MoveTarget - abs(curDist)))+ MoveMinSpeed;
-				if(ProfileContinuous && StepNDX < Steps.size() - 1)
-				{
-					if((int)Steps[StepNDX+1].Command != 3) //check for pause as next step
-					{
-						if(MoveMaxSpeed > MoveNextSpeed)
-						{
-							if (outSpeed <  MoveNextSpeed) outSpeed = MoveNextSpeed;
-						}
-						else
-						{
-							if (outSpeed >  MoveNextSpeed) outSpeed = MoveNextSpeed;
-						}
-					}
-				}
-			}
-			//printf("step= %f, dist= %5.2f, outspeed= %5.2f\n",curStep,curDist,outSpeed);
+			const MoveParams &mp = Steps[StepNDX].Move;
+			double t = (ProfileClock->GetFPGATime() - MoveStartTime) / 1000000.0;
+			TrajectorySample sample = LookupTrajectory(GetTrajectory(mp),mp.TrajCount,mp.TrajDt,t);
+			double minSpeed = fabs(MoveMinSpeed);
+			outSpeed = minSpeed;
+			if(MoveCruise > 0) outSpeed += (fabs(MoveMaxSpeed) - minSpeed) * sample.Velocity / MoveCruise;
+			outSpeed += ProfileMoveKp * (sample.Position - dist);
+			//never drop below the speed needed to keep the robot moving
+			if(outSpeed < minSpeed) outSpeed = minSpeed;
+			if(MoveMaxSpeed < 0) outSpeed = -outSpeed;
+			//printf("t= %f, dist= %5.2f, tgt= %5.2f, outspeed= %5.2f\n",t,dist,sample.Position,outSpeed);
 			return outSpeed;
 		}
 		else
 		{
 			Steps[StepNDX].DoneFlag = true; //Done Flag
-			ElapsedTime = (RobotController::GetFPGATime() - MoveStartTime) / 1000;
-			printf("Motion Time = %ju ms\n",ElapsedTime);
+			ElapsedTime = (ProfileClock->GetFPGATime() - MoveStartTime) / 1000;
+			Logger::Write(kLogMotionTime,StepNDX,ElapsedTime);
+			return 0.0f;
+		}
+	}
+	catch(std::exception& ex)
+	{
+		std::string err_string = "[Get_Trajectory] ";
+		err_string += ex.what();
+		printf(err_string.c_str());
+		return 0.0f;
+	}
+}
+
+//Follows the step's path table by time since the step started.
+//The outside wheel gets the trajectory speed mapping used by MOVE, Curve gets the
+//wheel speed ratio for the path curvature plus steering onto the path heading.
+double Profile::Get_Path(double heading, double curDist)
+{
+	double outSpeed = 0.0f;
+
+	try
+	{
+		double dist = fabs(curDist);
+		if(dist < MoveTarget)
+		{
+			const MoveParams &mp = Steps[StepNDX].Move;
+			double t = (ProfileClock->GetFPGATime() - MoveStartTime) / 1000000.0;
+			PathSample sample = LookupPath(&PathPool[mp.TrajStart],mp.TrajCount,mp.TrajDt,t);
+			double halfTrack = fabs(sample.Curvature) * ProfileTrackWidth / 2;
+			double outer = sample.Velocity * (1 + halfTrack);
+			double inner = sample.Velocity * (1 - halfTrack);
+			double minSpeed = fabs(MoveMinSpeed);
+			outSpeed = minSpeed;
+			if(MoveCruise > 0) outSpeed += (fabs(MoveMaxSpeed) - minSpeed) * outer / MoveCruise;
+			outSpeed += ProfileMoveKp * (sample.WheelDistance - dist);
+			if(outSpeed < minSpeed) outSpeed = minSpeed;
+
+			double feedForward = GetCurveForWheels(inner,outer);
+			if(sample.Curvature < 0) feedForward = -feedForward;
+			double tgtHeading = fmod(MoveStartHeading + sample.Heading,360.0);
+			if(tgtHeading < 0) tgtHeading += 360;
+			double curError = GetNormalizedError(heading,tgtHeading);
+			Curve = Clamp(feedForward + SteerPID.Update(0.0,curError,ProfileClock->GetFPGATime()));
+			return -outSpeed;
+		}
+		else
+		{
+			Steps[StepNDX].DoneFlag = true; //Done Flag
+			ElapsedTime = (ProfileClock->GetFPGATime() - MoveStartTime) / 1000;
+			Logger::Write(kLogMotionTime,StepNDX,ElapsedTime);
+			Curve = 0.0;
 			return 0.0f;
 		}
 	}
 	catch(std::exception& ex)
 	{
-		std::string err_string = "[Get_Trapezoid] ";
+		std::string err_string = "[Get_Path] ";
 		err_string += ex.what();
 		printf(err_string.c_str());
 		return 0.0f;
 	}
 }
 
+//Tracks the step's path by time since the step started with Ramsete from ProfilePose.
+//The path is placed in the field at the pose where the step started.  The step is
+//done when the path time is up and the robot has caught up to the end of it.
+double Profile::Follow_Path()
+{
+	try
+	{
+		const MoveParams &mp = Steps[StepNDX].Move;
+		double t = (ProfileClock->GetFPGATime() - MoveStartTime) / 1000000.0;
+		PathSample sample = LookupPath(&PathPool[mp.TrajStart],mp.TrajCount,mp.TrajDt,t);
+		double originHeading = PathOrigin.Heading * M_PI / 180;
+		Pose2d ref;
+		ref.X = PathOrigin.X + sample.X * cos(originHeading) - sample.Y * sin(originHeading);
+		ref.Y = PathOrigin.Y + sample.X * sin(originHeading) + sample.Y * cos(originHeading);
+		ref.Heading = PathOrigin.Heading + sample.Heading;
 
+		double velocity, turnRate;
+		Follower.Calculate(ProfilePose,ref,sample.Velocity,sample.Velocity * sample.Curvature,&velocity,&turnRate);
+		double duration = PathPool[mp.TrajStart + mp.TrajCount - 1].Time;
+		if(t >= duration && (Follower.AlongTrackError < 0.25 || t > duration + 1.0))
+		{
+			Steps[StepNDX].DoneFlag = true; //Done Flag
+			ElapsedTime = (ProfileClock->GetFPGATime() - MoveStartTime) / 1000;
+			Logger::Write(kLogMotionTime,StepNDX,ElapsedTime);
+			Curve = 0.0;
+			return 0.0f;
+		}
 
+		//wheel speeds for the commanded motion, the faster wheel is the outside of the turn
+		if(velocity < 0) velocity = 0;
+		double left = velocity + turnRate * ProfileTrackWidth / 2;
+		double right = velocity - turnRate * ProfileTrackWidth / 2;
+		double outer = fmax(fabs(left),fabs(right));
+		double inner = fabs(left) >= fabs(right) ? right : left;
+		//min speed only once the wheels are asked to move or the robot creeps past the end
+		double minSpeed = fabs(MoveMinSpeed);
+		double outSpeed = 0.0;
+		if(MoveCruise > 0 && outer > 0.05) outSpeed = minSpeed + (fabs(MoveMaxSpeed) - minSpeed) * outer / MoveCruise;
+		Curve = GetCurveForWheels(inner,outer);
+		if(left < right) Curve = -Curve;
+		Curve = Clamp(Curve);
+		return -outSpeed;
+	}
+	catch(std::exception& ex)
+	{
+		std::string err_string = "[Follow_Path] ";
+		err_string += ex.what();
+		printf(err_string.c_str());
+		return 0.0f;
+	}
+}
 
+double Profile::GetCurveForWheels(double inner, double outer)
+{
+	if(outer <= 0) return 0.0;
+	double ratio = inner / outer;
+	if(ratio >= 1.0) return 0.0;
+	if(ratio < -1.0) ratio = -1.0;
+	//inverse of ratio = (log(curve) - s) / (log(curve) + s) in Auto_Drive, written for inner/outer
+	return exp(ProfileCurveSensitivity * (ratio + 1) / (ratio - 1));
+}
 
+double Profile::GetWheelsForCurve(double curve)
+{
+	double c = fabs(Clamp(curve));
+	if(c == 0.0) return 1.0;
+	if(c >= 1.0) return -1.0;
+	double value = log(c);
+	//Auto_Drive divides the inside wheel by (value - s) / (value + s)
+	return (value + ProfileCurveSensitivity) / (value - ProfileCurveSensitivity);
+}
 
+PathLimits Profile::GetPathLimits(double maxSpeed)
+{
+	PathLimits limits;
+	limits.MaxVelocity = fabs(maxSpeed) * ProfileMaxVelocity;
+	limits.MaxAccel = ProfileMaxAccel;
+	limits.MaxLateralAccel = ProfileMaxLateralAccel;
+	limits.TrackWidth = ProfileTrackWidth;
+	return limits;
+}
 
+double Profile::GetStepMaxVelocity(const MoveParams &mp)
+{
+	PathLimits limits = GetPathLimits(mp.MaxSpeed);
+	if(mp.Curve == 0.0) return limits.MaxVelocity;
+	return MaxArcWheelVelocity(GetWheelsForCurve(mp.Curve),limits);
+}
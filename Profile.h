@@ -6,11 +6,12 @@
  *
  *  This library can store a set of movement commands and execute the commands
  *  to drive the robot in a pre-set pattern.  This is most useful for autonomous mode.
- *  Right now four commands are implemented:
+ *  Right now five commands are implemented:
  *     MOVE  (drive in a straight line for a certain distance)
  *     TURN  (turn to a new heading)
  *     PAUSE (pause for a period of milliseconds)
  *     CURVE (drive in a curved line for a certain distance)
+ *     SPLINE (drive a smooth path through waypoints without stopping to turn)
  *
  *	02/02/2017   -  CRM  -  corrected GetNormalizedError function (this early version used in competition for 2017)
  *	02/24/2017   -  CRM  -  added pause command
@@ -20,98 +21,211 @@
  *	04/28/2017   -  CRM  -  changed static arrays to vector of struct
  *	11/16/2017   -  CRM  -  fixed bug in initializing struct values, cleaned up printf's
  *	11/21/2017   -  CRM  -  simplified function parameters, using feet unit for distance by default
+ *	10/17/2026   -  replaced 1/4" distance slices with trajectory tables built when a step is added
+ *	10/17/2026   -  added S-curve motion type, accel and jerk limits captured per step
+ *	10/17/2026   -  added spline command (quintic Hermite path through waypoints)
+ *	10/17/2026   -  added Ramsete path follower for spline steps, driven by a field pose
+ *	10/17/2026   -  replaced vector of struct with a fixed step table, typed commands and per command params
+ *	10/17/2026   -  step start/done messages go to the Logger ring instead of printf
+ *	10/17/2026   -  gains can be loaded from a file written by the AutoTune tool
+ *	10/17/2026   -  steer and turn loops timed from the clock, gains set per step instead of flipping ProfileSteerKp
+ *	10/17/2026   -  step table readable so MOVE and PAUSE steps can be streamed to the Talons
+ *	10/17/2026   -  Restart runs a loaded profile again, autonomous plans are built once at RobotInit
+ *	10/17/2026   -  AddMove takes a trajectory table built by the compiler
+ *	10/17/2026   -  settings split from the steps so plans copy only them, pools sized per profile
+ *	10/17/2026   -  curve and spline speeds limited so the outside wheel never saturates (VelocityPlanner)
  *
  */
 
 #ifndef Profile_h
 #define Profile_h
 
-#include "RobotController.h"
+#include "RobotIO.h"
 #include "PID.h"
+#include "Trajectory.h"
+#include "Spline.h"
+#include "Pose.h"
+#include "Ramsete.h"
 #include "stdlib.h"
-#include "Timer.h"
-#include <vector>
 #include <string>
 #include <fstream>
 #include <sstream>
 
+typedef enum {kProfileNone,kProfileMove,kProfileTurn,kProfilePause,kProfileCurve,kProfileSpline} ProfileCommand;
+
+//MOVE, CURVE and SPLINE
+struct MoveParams
+{
+	float MinSpeed;
+	float MaxSpeed;
+	float Curve;
+	float MaxAccel;
+	float MaxJerk;			//0 = trapezoid
+	uint16_t TrajStart;		//first sample of this step in the trajectory pool (path pool for SPLINE)
+	const TrajectorySample *Table;	//compiled table for a MOVE instead of the pool, NULL if planned here
+	uint16_t TrajCount;
+	double TgtDistance;
+	double TrajDt;
+};
+
+struct TurnParams
+{
+	double TgtHeading;
+	double TurnSpeed;
+};
+
+struct PauseParams
+{
+	double PauseTime;
+};
+
 struct ProfileParams
 {
-	double Command = 0.0f;
-    double MinSpeed = 0.0f;
-    double MaxSpeed = 0.0f;
-    double TurnSpeed = 0.0f;
-    double TgtDistance = 0.0f;
-    double TgtHeading = 0.0f;
-    double PauseTime = 0.0f;
-    double Curve = 0.0f;
-    bool StartFlag = false;
-    bool DoneFlag = false;
+	ProfileCommand Command;
+	bool StartFlag;
+	bool DoneFlag;
+	union
+	{
+		MoveParams Move;
+		TurnParams Turn;
+		PauseParams Pause;
+	};
+	ProfileParams() : Command(kProfileNone), StartFlag(false), DoneFlag(false), Move() {}
 };
 
-class Profile
+//speeds, limits and gains of a profile, copied on their own from one profile to the plans
+//built from it (Profile::SetSettings) without the steps and tables
+struct ProfileSettings
+{
+	typedef enum {kMotionTrapezoid,kMotionSCurve} MotionType;
+	//defaults of the limits below, for tables built by the compiler
+	static constexpr double kDefaultMaxVelocity = 12.0;
+	static constexpr double kDefaultMaxAccel = 15.0;
+	static constexpr double kDefaultTrajectoryDt = 0.01;
+
+	bool ProfileContinuous = false;
+	double ProfileMinSpeed = 0.35;
+	double ProfileMaxSpeed = 1.00;
+	double ProfileMinTurnSpeed = 0.35;
+	double ProfileMaxTurnSpeed = 1.0;
+	//steer and turn gains are magnitudes, Ki per degree second and Kd per degree/second
+	double ProfileSteerKp = -0.01;
+	double ProfileSteerKi = 0.00;
+	double ProfileSteerKd = 0.00;
+	double ProfileTurnKp = 0.05;
+	double ProfileTurnKi = 0.00;
+	double ProfileTurnKd = 0.00;
+	double ProfileDerivativeFilter = 0.05;	//seconds, low pass on the steer and turn D terms
+	double ProfileMaxVelocity = kDefaultMaxVelocity;	//ft/s with output at 1.0
+	double ProfileMaxAccel = kDefaultMaxAccel;		//ft/s^2
+	double ProfileMaxJerk = 60.0;		//ft/s^3, used by kMotionSCurve
+	MotionType ProfileMotion = kMotionTrapezoid;
+	double ProfileMoveKp = 0.2;			//output added per foot behind the trajectory
+	double ProfileTrajectoryDt = kDefaultTrajectoryDt;	//seconds between trajectory samples
+	double ProfileMaxLateralAccel = 8.0;	//ft/s^2, limits speed through spline and curve steps
+	double ProfileTrackWidth = 2.0;		//feet between left and right wheels
+	double ProfileCurveSensitivity = 0.75;	//must match m_sensitivity in Robot::Auto_Drive
+	bool ProfileTrace = false;			//log heading, distance and outputs every cycle
+	bool ProfileFollower = false;		//track spline steps with Ramsete from ProfilePose
+};
+
+class Profile : public ProfileSettings
 {
 private:
-	std::vector <ProfileParams> Steps;
+	static const uint kMaxSteps = 32;
+	ProfileParams Steps[kMaxSteps];
+	uint StepCount = 0;
 	uint StepNDX;
 	double StartDistance;
 	double MoveStartHeading;
+	double TurnStartError = 0.0;
 	uint64_t MoveStartTime = 0;
 	uint64_t PauseTime = 0;
 	uint64_t ElapsedTime = 0;
-	double MoveSteps = 128;
 	double MoveMinSpeed;
 	double MoveMaxSpeed;
-	double MoveNextSpeed;
-	double MoveLastSpeed;
-	double MoveAccel;
-	double MoveFirstCorner;
-	double MoveSecondCorner;
-	double MoveSlice;
+	double MoveCruise;
 	double MoveTarget;
-	double MoveLastDist = 0.0f;
-	uint MoveDistCount = 0;
+	TrajectorySample *TrajPool;
+	uint TrajPoolSize;
+	uint TrajPoolUsed = 0;
+	PathSample *PathPool;
+	uint PathPoolSize;
+	uint PathPoolUsed = 0;
+	RamseteController Follower;
+	Pose2d PathOrigin;
+	double PoseLastDistance = 0.0;
 	PID TurnPID;
 	PID SteerPID;
+	Clock *ProfileClock;
 
 public:
 	typedef enum {kProfileForward,kProfileReverse} DirectionType;
+	//pool sizes of a profile built on its own, plans that know their size can ask for less
+	static const uint kTrajPoolSize = 4096;
+	static const uint kPathPoolSize = 2048;
 
 	bool ProfileLoaded = false;
-	bool ProfileContinuous = false;
 	bool ProfileCompleted = false;
 	int  ProfileStep = 0;
-	double ProfileMinSpeed = 0.35;
-	double ProfileMaxSpeed = 1.00;
-	double ProfileMinTurnSpeed = 0.35;
-	double ProfileMaxTurnSpeed = 1.0;
-	double ProfileSteerKp = -0.01;
-	double ProfileSteerKi = 0.00;
-	double ProfileSteerKd = 0.00;
-	double ProfileTurnKp = 0.05;
-	double ProfileTurnKi = 0.00;
-	double ProfileTurnKd = 0.00;
+	Pose2d ProfilePose;					//robot pose used by the follower
 	float OutputMagnitude;
 	float Curve;
 
 
 
-    Profile();
+    //the pools hold the trajectory and path samples of every step, allocated here and never again
+    Profile(Clock *clock, uint trajPoolSize = kTrajPoolSize, uint pathPoolSize = kPathPoolSize);
+    ~Profile();
+    Profile(const Profile &) = delete;
+    Profile &operator=(const Profile &) = delete;
+    //take the speeds, limits and gains of another profile, call Initialize and add the steps after
+    void SetSettings(const ProfileSettings &settings) { ProfileSettings::operator=(settings); }
     //call this before doing anything else
     void Initialize();
+    //call this to run the loaded steps again from the first, the steps and trajectory tables are kept
+    void Restart();
     //call this to zero profile steps array
     int ClearProfile();
+    //set ProfileContinuous, speeds and limits before adding steps, they are captured per step
     //call this to add move step to profile array
     int AddMove(DirectionType Direction, double TgtDistance);
+    //same with a table from TRAJECTORY_TABLE, used in place if it was planned with this profile's
+    //limits for the step, otherwise the move is planned here as above
+    template<int N>
+    int AddMove(DirectionType Direction, const TrajectoryTable<N> &table)
+    {
+        return AddTableMove(Direction,table.Distance,table.Limits,table.Samples,table.Count,table.Dt);
+    }
     //call this to add turn step to profile array
     int AddTurn(double TgtHeading, double speed);
     //call this to add pause step to profile array
     int AddPause(double mSecs);
     //call this to add curve step to profile array
     int AddCurve(DirectionType Direction, double TgtDistance, double Curve);
+    //call this to add spline step to profile array, always drives forward
+    //waypoints are relative to the robot when the step starts: X fwd, Y right, Heading clockwise
+    int AddSpline(const Waypoint *waypoints, int count);
     //call this repeatedly in AutonomousPeriodic
     //then set .Drive method with Profile.OutputMagnitude,Profile.Curve
     void ExecuteProfile(double heading, double distance);
+    //same as above with a field pose for the path follower (from odometry)
+    //the two argument version dead reckons ProfilePose from heading and distance
+    void ExecuteProfile(double heading, double distance, const Pose2d &pose);
+
+    //read name=value lines (# comments) over the gains above, returns how many were set or -1
+    //call at RobotInit so tuned gains replace the defaults
+    int LoadGains(const char *path);
+    //write the gains LoadGains reads, returns -1 if the file can't be written
+    int SaveGains(const char *path);
+
+    //loop terms of the last update, for telemetry
+    const PID &GetSteerPID() const { return SteerPID; }
+    const PID &GetTurnPID() const { return TurnPID; }
+    //step table and trajectory samples, for running the steps somewhere else (MotionStreamer)
+    uint GetStepCount() const { return StepCount; }
+    const ProfileParams &GetStep(uint stepNDX) const { return Steps[stepNDX]; }
+    const TrajectorySample *GetTrajectory(const MoveParams &mp) const { return mp.Table != NULL ? mp.Table : &TrajPool[mp.TrajStart]; }
 
     //********* INTERNAL METHODS **********
     //normalize heading value to 0-360 degrees
@@ -120,10 +234,35 @@ public:
     double GetNormalizedError(double heading, double newHeading);
     //enforce limits of -1 to 1
 	double Clamp(double steerRate);
-	//setup motion profile
-	void Set_Trapezoid(double tgtValue, double minSpeed, double maxSpeed, double lastSpeed, double nextSpeed);
-	//call repeatedly to execute motion profile based on distance feedback
-	double Get_Trapezoid(double curDist);
+	//load the steering gains with the sign for the drive direction and restart the loop
+	void StartSteer(double speed);
+	//claim the next entry of the step table, NULL if it is full
+	ProfileParams *NewStep(ProfileCommand command);
+	//build the trajectory table for a MOVE or CURVE step from its limits and neighbours
+	int BuildTrajectory(uint stepNDX);
+	//called by Add functions to build the new step and re-plan the one before it if continuous
+	int AddTrajectory();
+	//speeds, distance and limits of a MOVE step from the profile settings
+	void SetMoveParams(MoveParams &mp, DirectionType Direction, double TgtDistance);
+	//AddMove for a compiled table
+	int AddTableMove(DirectionType Direction, double TgtDistance, const MotionLimits &limits,
+			const TrajectorySample *samples, int count, double dt);
+	//setup motion profile for the current step
+	void Set_Trajectory();
+	//call repeatedly to execute motion profile based on time and distance feedback
+	double Get_Trajectory(double curDist);
+	//call repeatedly to follow a spline step, sets Curve and returns the outside wheel speed
+	double Get_Path(double heading, double curDist);
+	//call repeatedly to track a spline step from ProfilePose with Ramsete, sets Curve
+	double Follow_Path();
+	//Curve value that makes Robot::Auto_Drive run the inside wheel at inner/outer of the outside wheel
+	double GetCurveForWheels(double inner, double outer);
+	//inside wheel speed over outside wheel speed Robot::Auto_Drive runs for a Curve value, the inverse of above
+	double GetWheelsForCurve(double curve);
+	//wheel limits for the planner from the profile settings, MaxVelocity at a step's MaxSpeed
+	PathLimits GetPathLimits(double maxSpeed);
+	//fastest outside wheel speed of a MOVE or CURVE step, a CURVE is held to the lateral acceleration
+	double GetStepMaxVelocity(const MoveParams &mp);
 };
 
 #endif
@@ -0,0 +1,28 @@
+/*
+ * Ramsete.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Ramsete.h"
+#include <math.h>
+
+void RamseteController::Calculate(const Pose2d &pose, const Pose2d &ref, double refVelocity, double refTurnRate,
+		double *velocity, double *turnRate)
+{
+	double theta = pose.Heading * M_PI / 180;
+	double dx = ref.X - pose.X;
+	double dy = ref.Y - pose.Y;
+	//error in the robot's frame
+	double ex = cos(theta) * dx + sin(theta) * dy;
+	double ey = -sin(theta) * dx + cos(theta) * dy;
+	double eTheta = remainder((ref.Heading - pose.Heading) * M_PI / 180,2 * M_PI);
+	AlongTrackError = ex;
+	CrossTrackError = ey;
+	HeadingError = eTheta;
+
+	double k = 2 * Zeta * sqrt(refTurnRate * refTurnRate + B * refVelocity * refVelocity);
+	double sinc = fabs(eTheta) < 1e-6 ? 1.0 - eTheta * eTheta / 6 : sin(eTheta) / eTheta;
+	*velocity = refVelocity * cos(eTheta) + k * ex;
+	*turnRate = refTurnRate + k * eTheta + B * refVelocity * sinc * ey;
+}
@@ -0,0 +1,35 @@
+/*
+ * Ramsete.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Ramsete nonlinear path follower.  Given the robot pose and the reference
+ *  pose/speed/curvature from a time indexed path, returns the forward speed
+ *  and turn rate that drive the error to zero.
+ *
+ *  Works in the Pose2d frame (Y right, heading clockwise), so a positive turn
+ *  rate is clockwise.  Gains are in feet: B = 2.0 / m^2 is 0.186 / ft^2.
+ *
+ */
+
+#ifndef SRC_RAMSETE_H_
+#define SRC_RAMSETE_H_
+
+#include "Pose.h"
+
+class RamseteController
+{
+public:
+	double B = 0.186;	//1/ft^2, larger converges harder
+	double Zeta = 0.7;	//damping, 0 to 1
+
+	//refVelocity ft/s, refTurnRate rad/s, outputs ft/s and rad/s
+	void Calculate(const Pose2d &pose, const Pose2d &ref, double refVelocity, double refTurnRate,
+			double *velocity, double *turnRate);
+	//error of the reference from the robot in the robot's frame
+	double AlongTrackError = 0.0;
+	double CrossTrackError = 0.0;
+	double HeadingError = 0.0;	//radians
+};
+
+#endif /* SRC_RAMSETE_H_ */
@@ -10,7 +10,14 @@
 *
 */
 #include "Robot.h"
-
+#include "AutoCommands.h"
+#ifndef ROBOT_SIM
+#include "FRCRobotIO.h"
+#include <chrono>
+#include <thread>
+#endif
+
+#ifndef ROBOT_SIM
 void Robot::RobotInit()
 {
 	SetPeriod(0.02);
@@ -32,11 +39,6 @@ void Robot::RobotInit()
 	ThumbWheel_2 = new DigitalInput(11); //DI on NAVX
 	ThumbWheel_4 = new DigitalInput(12); //DI on NAVX
 	ThumbWheel_8 = new DigitalInput(13); //DI on NAVX
-	AutoProfile = new Profile();
-	ElapsedTimer = new Timer();
-	ElapsedTimer->Start();
-	AutoTimer = new Timer();
-	AutoTimer->Start();
 	DriveTrain->SetSafetyEnabled(false);
 	MotorRF->SetSafetyEnabled(false);
 	MotorLF->SetSafetyEnabled(false);
@@ -98,85 +100,305 @@ void Robot::RobotInit()
 		err_string += ex.what();
 		DriverStation::ReportError(err_string.c_str());
 	}
+	FRCRobotIO *hardware = new FRCRobotIO(MotorLF,MotorRF,MotorLift,MotorArm,MotorGrip,PotArm,LimitLiftHi,LimitLiftLo,
+			ThumbWheel_1,ThumbWheel_2,ThumbWheel_4,ThumbWheel_8,Gyro);
+	ControlInit(hardware,DriveLoop::kDefaultRate);
+	//gains from the AutoTune tool, the defaults in Profile.h are kept if the file is missing
+	if(BaseProfile->LoadGains("/home/lvuser/gains.txt") > 0) BuildPlans();
+	//thumbwheel 7, reloaded while disabled when the file changes
+	LoadScript("/home/lvuser/auto.txt");
+	//status frames for the job each Talon does, the masters' encoders once per drive loop tick
+	CanBus = new CanScheduler(DriveLoopRate,AutoStreamMoves);
+	CanBus->AddDevice(new TalonCanDevice(MotorLF),kCanDriveMaster);
+	CanBus->AddDevice(new TalonCanDevice(MotorRF),kCanDriveMaster);
+	CanBus->AddDevice(new TalonCanDevice(MotorLR),kCanDriveFollower);
+	CanBus->AddDevice(new TalonCanDevice(MotorRR),kCanDriveFollower);
+	CanBus->Configure();
+	CanBus->Report();
+	hardware->SetCanScheduler(CanBus);
+	OpenTelemetry("/home/lvuser/telemetry.bin");
+	//print the control loop's log records from a background thread
+	Logger::StartFlusher(0.1);
+	if(Drive != NULL)
+	{
+		DriveNotifier = new Notifier([this]
+		{
+			//first tick on the notifier thread gets it a log ring stamped by the hardware clock
+			static thread_local bool attached = false;
+			if(!attached)
+			{
+				Logger::Init(HardwareIO);
+				attached = Logger::AttachThread();
+			}
+			DriveLoopTick();
+		});
+		DriveNotifier->StartPeriodic(1.0 / DriveLoopRate);
+	}
+	if(AutoStreamMoves)
+	{
+		double kP, kF;
+		MotionStreamer::GetTalonGains(*BaseProfile,mag_FeetPerPulse,&kP,&kF);
+		AttachStream(new MotionStreamer(HardwareIO,new TalonProfileBuffer(MotorLF,kP,kF,CanBus),
+				new TalonProfileBuffer(MotorRF,kP,kF,CanBus),mag_FeetPerPulse));
+		//forward is negative output on the left Talon, positive on the right
+		Stream->SetDirections(kLeftEncoderSign,kRightEncoderSign);
+		StreamNotifier = new Notifier([this]
+		{
+			static thread_local bool attached = false;
+			if(!attached)
+			{
+				Logger::Init(HardwareIO);
+				attached = Logger::AttachThread();
+			}
+			Stream->Service();
+		});
+		//twice the point rate, the Talons take one point per ProcessBuffer
+		StreamNotifier->StartPeriodic(MotionStreamer::kPointMs / 2000.0);
+	}
 	//camera = CameraServer::GetInstance()->StartAutomaticCapture();
 }
+#endif
+
+void Robot::ControlInit(RobotIO *io, double driveLoopRate)
+{
+	Recorder = new Telemetry();
+	IO = new TelemetryRobotIO(io,Recorder);
+	Logger::Init(IO);
+	Logger::AttachThread();
+	//time the loop from the hardware clock, the recorder's clock stands still during a cycle
+	LoopProbe = new LoopTiming(io,LoopBudget);
+	HardwareIO = io;
+	DriveLoopRate = driveLoopRate;
+	//the drive loop runs between 50Hz cycles, so its profiles read the hardware clock
+	Clock *profileClock = IO;
+	if(DriveLoopRate > 0)
+	{
+		profileClock = io;
+		Drive = new DriveLoop(io,mag_FeetPerPulse);
+		Drive->SetEncoderSigns(kLeftEncoderSign,kRightEncoderSign);
+	}
+	BaseProfile = new Profile(profileClock,0,0);	//settings only, never runs steps
+	for(int r = 0; r < kAutoRoutines; r++)
+		for(int c = 0; c < kAutoChoices; c++) AutoPlans[r][c] = new Profile(profileClock,kPlanTrajSamples,kPlanPathSamples);
+	Script = new AutoScript();
+	for(int l = 0; l < AutoScript::kLayouts; l++) ScriptPlans[l] = new Profile(profileClock,kScriptTrajSamples,0);
+	AutoProfile = BaseProfile;
+	ElapsedTimer = new IOTimer(IO);
+	AutoTimer = new IOTimer(IO);
+	DriveOdometry = new Odometry(mag_FeetPerPulse);
+	DriveOdometry->LeftEncoderSign = kLeftEncoderSign;
+	DriveOdometry->RightEncoderSign = kRightEncoderSign;
+	Scheduler = new CommandScheduler();
+	BuildRoutines();
+	BuildPlans();
+}
+
+void Robot::BuildPlans()
+{
+	for(int r = 0; r < kAutoRoutines; r++)
+		for(int c = 0; c < kAutoChoices; c++)
+		{
+			Profile *plan = AutoPlans[r][c];
+			plan->SetSettings(*BaseProfile);
+			//set min/max speed range for forward/backward moves
+			plan->ProfileMinSpeed = kAutoMinSpeed;
+			plan->ProfileMaxSpeed = kAutoMaxSpeed;
+			plan->Initialize();
+			plan->ClearProfile();
+			BuildPlan(plan,r + 1,c);
+			plan->ProfileLoaded = true;
+		}
+	BuildScriptPlans();
+}
+
+void Robot::SetAutoUseSplines(bool use)
+{
+	AutoUseSplines = use;
+	BuildPlans();
+}
+
+void Robot::SetAutoFollower(bool follow)
+{
+	BaseProfile->ProfileFollower = follow;
+	if(follow) AutoUseSplines = true;
+	BuildPlans();
+}
+
+void Robot::BuildScriptPlans()
+{
+	for(int l = 0; l < AutoScript::kLayouts; l++)
+	{
+		Profile *plan = ScriptPlans[l];
+		plan->SetSettings(*BaseProfile);
+		plan->ProfileMinSpeed = kAutoMinSpeed;
+		plan->ProfileMaxSpeed = kAutoMaxSpeed;
+		plan->Initialize();
+		plan->ClearProfile();
+		Script->BuildProfile(plan,l);
+		plan->ProfileLoaded = true;
+	}
+}
+
+int Robot::LoadScript(const char *path)
+{
+	ScriptPath = path;
+	ScriptModified = AutoScript::GetModifiedTime(path);
+	AutoScript loaded;
+	uint64_t start = HardwareIO->GetFPGATime();
+	int count = loaded.LoadFile(path);
+	uint64_t parsed = HardwareIO->GetFPGATime();
+	if(count < 0)
+	{
+		Logger::Write(kLogScriptFailed,loaded.GetErrorLine());
+		return -1;
+	}
+	*Script = loaded;
+	BuildScriptPlans();
+	Logger::Write(kLogScriptLoaded,count,parsed - start,HardwareIO->GetFPGATime() - parsed);
+	return count;
+}
+
+void Robot::CheckScript()
+{
+	//once a second, the file time is a system call
+	if(ScriptPath.empty() || ++ScriptCheckCycles < 50) return;
+	ScriptCheckCycles = 0;
+	if(AutoScript::GetModifiedTime(ScriptPath.c_str()) != ScriptModified) LoadScript(ScriptPath.c_str());
+}
+
+void Robot::DriveLoopTick()
+{
+	if(Drive != NULL) Drive->Tick();
+}
+
+int Robot::GetDriveLoopTicks()
+{
+	return int(DriveLoopRate * 0.02 + 0.5);
+}
+
+void Robot::StopDriveLoop()
+{
+	//the fill thread disables the Talons on its next pass if they were mid profile
+	if(Stream != NULL && Stream->IsActive()) Stream->Stop();
+	StreamChecked = false;
+	Streaming = false;
+	if(Drive == NULL || (!Drive->IsActive() && Drive->IsStopped())) return;
+	Drive->Stop();
+#ifndef ROBOT_SIM
+	//the notifier may be part way through a tick with the profile
+	for(int i = 0; i < 20 && !Drive->IsStopped(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+}
 
 void Robot::AutonomousInit()
 {
-	AutoState = 0;
-	//set min/max speed range for forward/backward moves
-	AutoProfile->ProfileMinSpeed = 0.35;
-	AutoProfile->ProfileMaxSpeed = 0.75;
-	//don't slow down between continuous movements
-	AutoProfile->ProfileContinuous = false;
-	AutoProfile->Initialize();
+	Scheduler->CancelAll();
+	StopDriveLoop();
+	AutoComplete = false;
 	//find out assignments for switch and plate from FMS
-	GameData = frc::DriverStation::GetInstance().GetGameSpecificMessage();
+	GameData = IO->GetGameData();
 	ThumbWheel = GetThumbWheel();  //determines which autonomous profile to run
+	//the plans were built at RobotInit, the first periodic starts driving
+	AutoChoice = GetAutoChoice(ThumbWheel,GameData);
+	AutoRoutine = NULL;
+	if(ThumbWheel >= 1 && ThumbWheel <= kAutoRoutines)
+	{
+		AutoProfile = AutoPlans[ThumbWheel - 1][AutoChoice];
+		AutoRoutine = AutoRoutines[ThumbWheel - 1][AutoChoice];
+	}
+	else if(ThumbWheel == kScriptThumbWheel)
+	{
+		int layout = AutoScript::GetLayout(GameData);
+		AutoProfile = ScriptPlans[layout];
+		ScriptRoutine->Load(Script,layout);
+		AutoRoutine = ScriptRoutine;
+	}
+	else AutoProfile = BaseProfile;
+	AutoProfile->Restart();
+	if(ThumbWheel >= 3 && ThumbWheel <= kAutoRoutines)
+	{
+		if(AutoChoice == 1) Logger::Write(kLogSwitchChosen);
+		if(AutoChoice == 2) Logger::Write(kLogScaleChosen);
+	}
+	Recorder->SetMatch(GameData,ThumbWheel,DriveLoopRate);
+	if(ThumbWheel == kScriptThumbWheel) Recorder->SetScript(Script->GetHash(),ScriptPath);
+	//the first record holds the heading offset and start time for replay
+	Recorder->BeginCycle(IO->GetFPGATime(),kModeAutonomousInit);
+	ReadSensors();
 	ZeroHeading();
 	//zero the encoders
-	MotorLF->SetSelectedSensorPosition(0,0,0);
-	MotorRF->SetSelectedSensorPosition(0,0,0);
+	IO->ZeroEncoders();
+	ResetOdometry();
 	AutoTimer->Reset();
+	if(AutoRoutine != NULL) Scheduler->Schedule(AutoRoutine);
+	RecordCycle();
+	LoopProbe->Restart();
 }
 
 void Robot::AutonomousPeriodic()
 {
+	LoopProbe->BeginCycle();
+	Recorder->BeginCycle(IO->GetFPGATime(),kModeAutonomous);
+	ReadSensors();
+	UpdateOdometry();
 	switch(ThumbWheel)
 	{
 		case 1:
-			//drive straight to cross line
-			Auto_Straight();
-			break;
 		case 2:
-			//if DATA = LXX place switch left else place switch right
-			Auto_SwitchFrom2();
-			break;
 		case 3:
-			//if DATA = LXX place switch else if DATA=XLX place scale else cross line
-			Auto_SwitchOrScaleFrom1();
-			break;
 		case 4:
-			//if DATA = RXX place switch else if DATA=XRX place scale else cross line
-			Auto_SwitchOrScaleFrom3();
-			break;
 		case 5:
-			//if DATA = XLX place scale else if DATA=LXX place switch else cross line
-			Auto_ScaleOrSwitchFrom1();
-			break;
 		case 6:
-			//if DATA = XRX place scale else if DATA=RXX place switch else cross line
-			Auto_ScaleOrSwitchFrom3();
+		case kScriptThumbWheel:
+			//command groups from BuildRoutines, or the script's task
+			Auto_Routine();
 			break;
 		default:
-			DriveTrain->ArcadeDrive(0.0,0.0);
-			MotorArm->Set(0.0);
-			MotorLift->Set(0.0);
-			MotorGrip->Set(0.0);
+			IO->SetDrive(0.0,0.0);
+			IO->SetArm(0.0);
+			IO->SetLift(0.0);
+			IO->SetGrip(0.0);
 			break;
 	}
+	RecordCycle();
+	if(CanBus != NULL) CanBus->EndCycle();
+	LoopProbe->EndCycle();
 }
 
+#ifndef ROBOT_SIM
 void Robot::TeleopInit()
 {
-	MotorLF->SetSelectedSensorPosition(0,0,0);
-	MotorRF->SetSelectedSensorPosition(0,0,0);
+	Scheduler->CancelAll();
+	StopDriveLoop();
+	ReadSensors();
+	IO->ZeroEncoders();
+	//keep the field pose from autonomous, only the encoder counts start over
+	DriveOdometry->Reset(GetPose(),0,0,GetHeading());
 	ElapsedTimer->Reset();
+	LoopProbe->Restart();
 }
 
 void Robot::TeleopPeriodic()
 {
+	LoopProbe->BeginCycle();
+	Recorder->BeginCycle(IO->GetFPGATime(),kModeTeleop);
+	ReadSensors();
+	UpdateOdometry();
 	double stickDriveX = StickDrive->GetRawAxis(0);
 	double stickDriveY = StickDrive->GetRawAxis(1);
 	double stickPlayX = StickPlay->GetRawAxis(0);
 	double stickPlayY = StickPlay->GetRawAxis(1);
 	double gripSpeedFactor = fabs(((StickPlay->GetRawAxis(3) * -1)+1.0f))/2.0f;
-	double posArm = PotArm->Get();
+	double posArm = Sensors.ArmPosition;
 
 	//drive via single joystick
 	if(fabs(stickDriveX) > 0.15 || fabs(stickDriveY) > 0.15)
 	{
 		DriveTrain->ArcadeDrive(stickDriveY,stickDriveX *-1,false);
+		//DifferentialDrive sets the Talons itself, record what it sent
+		TelemetryRecord *rec = Recorder->Current();
+		rec->DriveLeft = MotorLF->Get();
+		rec->DriveRight = MotorRF->Get();
 	}
 	else DriveTrain->StopMotor();
 
@@ -185,32 +407,48 @@ void Robot::TeleopPeriodic()
 	{
 		if (stickPlayX > 0) stickPlayX -= 0.25;
 		else stickPlayX += 0.25;
-		MotorLift->Set(GetLiftSpeed(stickPlayX,!LimitLiftLo->Get(),!LimitLiftHi->Get()));
+		IO->SetLift(GetLiftSpeed(stickPlayX,!Sensors.LimitLiftLo,!Sensors.LimitLiftHi));
 	}
 	else
 	{
-		MotorLift->StopMotor();
+		IO->SetLift(0.0);
 	}
 
 	if(fabs(stickPlayY) > 0.25)
 	{
 		if (stickPlayY > 0) stickPlayY -= 0.25;
 		else stickPlayY += 0.25;
-		MotorArm->Set(GetArmSpeed(stickPlayY,posArm,7.5,1.5,1.0,0.0));
+		IO->SetArm(GetArmSpeed(stickPlayY,posArm,7.5,1.5,1.0,0.0));
 	}
 	else
 	{
-		MotorArm->StopMotor();
+		IO->SetArm(0.0);
 	}
 
 	//Run the Gripper
-	MotorGrip->Set(GetGripSpeed(StickPlay->GetRawButton(4),StickPlay->GetRawButton(5),gripSpeedFactor));
+	IO->SetGrip(GetGripSpeed(StickPlay->GetRawButton(4),StickPlay->GetRawButton(5),gripSpeedFactor));
 
 	//Show debug info
 	if(ElapsedTimer->HasPeriodPassed(1.0))
 	{
 		ElapsedTimer->Reset();
-		printf("ArmPos= %.1f LiftLO=%d LiftHI=%d Yaw=%f.1 Dist=%f.1\n",posArm,LimitLiftLo->Get(),LimitLiftHi->Get(),GetHeading(),GetDistance());
+		Logger::Write(kLogTeleopStatus,posArm,Sensors.LimitLiftLo,Sensors.LimitLiftHi,GetHeading(),GetDistance());
+	}
+	RecordCycle();
+	if(CanBus != NULL) CanBus->EndCycle();
+	LoopProbe->EndCycle();
+}
+
+//report the loop timing of the mode that just ended
+void Robot::DisabledInit()
+{
+	Scheduler->CancelAll();
+	StopDriveLoop();
+	if(LoopProbe->GetExecution().GetCount() > 0)
+	{
+		LoopProbe->Report();
+		if(Drive != NULL) Drive->RequestReport();
+		if(CanBus != NULL) CanBus->Report();
 	}
 }
 
@@ -220,7 +458,9 @@ void Robot::DisabledPeriodic()
 	MotorRF->SetNeutralMode(NeutralMode::Brake);
 	MotorLR->SetNeutralMode(NeutralMode::Brake);
 	MotorRR->SetNeutralMode(NeutralMode::Brake);
+	CheckScript();
 }
+#endif
 
 double Robot::GetArmSpeed(double stickY, double pos, double pMax, double pMin, double sMax, double sMin)
 {
@@ -251,6 +491,7 @@ double Robot::GetGripSpeed(bool butIntake, bool butReject, double speedFactor)
 	return ret;
 }
 
+#ifndef ROBOT_SIM
 void Robot::SetRampRate(double secs)
 {
 	MotorLF->ConfigOpenloopRamp(secs,10);
@@ -258,31 +499,106 @@ void Robot::SetRampRate(double secs)
 	MotorLR->ConfigOpenloopRamp(secs,10);
 	MotorRR->ConfigOpenloopRamp(secs,10);
 }
+#endif
+
+void Robot::ReadSensors()
+{
+	//through the recorder, so the sample is stored for replay
+	IO->ReadSensors(&Sensors);
+}
 
 double Robot::GetHeading()
 {
-	double offsetYaw = AutoProfile->GetNormalizedHeading(Gyro->GetYaw()) - HeadingOffset;
+	double offsetYaw = AutoProfile->GetNormalizedHeading(Sensors.Yaw) - HeadingOffset;
 	if(offsetYaw < 0) offsetYaw += 360;
 	return offsetYaw;
 }
 
 void Robot::ZeroHeading()
 {
-	HeadingOffset = AutoProfile->GetNormalizedHeading(Gyro->GetYaw());
+	HeadingOffset = AutoProfile->GetNormalizedHeading(Sensors.Yaw);
 }
 
 double Robot::GetDistance()
 {
-	return MotorRF->GetSelectedSensorPosition(0) * mag_FeetPerPulse;
-	//return MotorRF->GetSensorCollection().GetQuadraturePosition() * mag_FeetPerPulse;
+	return Sensors.RightEncoder * mag_FeetPerPulse;
+}
+
+//the encoders were just zeroed, their counts may not read back as zero until the next CAN frame
+void Robot::ResetOdometry()
+{
+	DriveOdometry->Reset(Pose2d(),0,0,GetHeading());
+}
+
+//call once at the top of each periodic so everything in the cycle sees the same pose
+void Robot::UpdateOdometry()
+{
+	DriveOdometry->Update(Sensors.LeftEncoder,Sensors.RightEncoder,GetHeading());
+}
+
+bool Robot::OpenTelemetry(const char *path)
+{
+	//64k records is over 20 minutes of 50Hz cycles
+	return Recorder->Open(path,65536);
+}
+
+//fill in the rest of the cycle's record and publish it, sensors and commands are
+//stored as they go through IO
+void Robot::RecordCycle()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	const Pose2d &pose = GetPose();
+	rec->PoseX = pose.X;
+	rec->PoseY = pose.Y;
+	rec->PoseHeading = pose.Heading;
+	//teleop drives without a profile, its commands are already in the record
+	if(rec->Mode == kModeTeleop)
+	{
+		Recorder->Commit();
+		return;
+	}
+	rec->AutoState = AutoRoutine != NULL ? AutoRoutine->GetStep() : 0;
+	if(Drive != NULL)
+	{
+		//the drive loop owns the profile, record its newest tick
+		const DriveStatus &status = Drive->GetStatus();
+		rec->ProfileStep = status.ProfileStep;
+		rec->OutputMagnitude = status.OutputMagnitude;
+		rec->Curve = status.Curve;
+		rec->SteerP = status.SteerP;
+		rec->SteerI = status.SteerI;
+		rec->SteerD = status.SteerD;
+		rec->TurnP = status.TurnP;
+		rec->TurnI = status.TurnI;
+		rec->TurnD = status.TurnD;
+		rec->DriveLeft = status.Left;
+		rec->DriveRight = status.Right;
+		Recorder->Commit();
+		return;
+	}
+	rec->ProfileStep = AutoProfile->ProfileStep;
+	rec->OutputMagnitude = AutoProfile->OutputMagnitude;
+	rec->Curve = AutoProfile->Curve;
+	rec->SteerP = AutoProfile->GetSteerPID().GetP();
+	rec->SteerI = AutoProfile->GetSteerPID().GetI();
+	rec->SteerD = AutoProfile->GetSteerPID().GetD();
+	rec->TurnP = AutoProfile->GetTurnPID().GetP();
+	rec->TurnI = AutoProfile->GetTurnPID().GetI();
+	rec->TurnD = AutoProfile->GetTurnPID().GetD();
+	Recorder->Commit();
+}
+
+const Pose2d &Robot::GetPose()
+{
+	return DriveOdometry->GetPose();
 }
 
 int Robot::GetThumbWheel()
 {
-	bool d1 = ThumbWheel_1->Get();
-	bool d2 = ThumbWheel_2->Get();
-	bool d4 = ThumbWheel_4->Get();
-	bool d8 = ThumbWheel_8->Get();
+	bool d1 = IO->GetThumbWheelBit(1);
+	bool d2 = IO->GetThumbWheelBit(2);
+	bool d4 = IO->GetThumbWheelBit(4);
+	bool d8 = IO->GetThumbWheelBit(8);
 
 	int ret = 0;
 	if(!d1 && d2 && d4 && !d8) ret = 9;
@@ -294,7 +610,7 @@ int Robot::GetThumbWheel()
 	if(!d1 && !d2 && d4 && d8) ret = 3;
 	if(d1 && !d2 && d4 && d8) ret = 2;
 	if(!d1 && d2 && d4 && d8) ret = 1;
-	printf("ThumbWheel= %d\n",ret);
+	Logger::Write(kLogThumbWheel,ret);
 	return ret;
 }
 
@@ -305,4 +621,6 @@ double ffilter(double raw, double current, double lpf)
 }
 
 
+#ifndef ROBOT_SIM
 START_ROBOT_CLASS(Robot)
+#endif
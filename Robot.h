@@ -8,13 +8,45 @@
 #ifndef SRC_ROBOT_H_
 #define SRC_ROBOT_H_
 
+#ifdef ROBOT_SIM
+#include "SimRobotBase.h"
+#else
 #include "AHRS.h"
-#include "Profile.h"
 #include "ctre/Phoenix.h"
 #include "WPILib.h"
+#endif
+#include "Profile.h"
+#include "RobotIO.h"
+#include "Odometry.h"
+#include "Logger.h"
+#include "Telemetry.h"
+#include "LoopTiming.h"
+#include "DriveLoop.h"
+#include "MotionStreamer.h"
+#include "CanScheduler.h"
+#include "AutoScript.h"
+#include "Command.h"
+
+class ScriptCommand;
 
 class Robot : public frc::TimedRobot
 {
+public:
+	static const int kAutoRoutines = 6;		//thumbwheel 1 to 6
+	static const int kAutoChoices = 3;		//GetAutoChoice
+	static const int kScriptThumbWheel = 7;	//runs the AutoScript
+	//speed range of forward/backward moves in every plan
+	static constexpr double kAutoMinSpeed = 0.35;
+	static constexpr double kAutoMaxSpeed = 0.75;
+	//samples each plan keeps for moves planned at run time (the compiled tables are not in them)
+	//and for splines, a full 15 s autonomous at the default dt fits in twice kPlanTrajSamples
+	static const uint kPlanTrajSamples = 1024;
+	static const uint kPlanPathSamples = 512;
+	static const uint kScriptTrajSamples = 2048;	//scripts plan every move at run time, no splines
+	//which way each drive encoder counts driving forward, from the Talon setup in RobotInit:
+	//both sides inverted with the same sensor phase and driven SetDrive(left,-right)
+	static constexpr double kLeftEncoderSign = -1.0;
+	static constexpr double kRightEncoderSign = 1.0;
 private:
 	Joystick *StickDrive;
 	Joystick *StickPlay;
@@ -34,13 +66,43 @@ private:
 	DigitalInput *ThumbWheel_2;
 	DigitalInput *ThumbWheel_4;
 	DigitalInput *ThumbWheel_8;
-	Profile *AutoProfile;
+	Profile *AutoProfile;		//the plan autonomous is running, picked from AutoPlans
+	Profile *BaseProfile;		//gains and limits every plan is built from
+	//every thumbwheel routine and game data choice, built ahead of autonomous
+	Profile *AutoPlans[kAutoRoutines][kAutoChoices];
+	CommandScheduler *Scheduler;
+	Command *AutoRoutines[kAutoRoutines][kAutoChoices];	//BuildRoutines
+	Command *AutoRoutine = NULL;	//scheduled at AutonomousInit
+	double AutoLiftDistance = 24.0;	//feet into a scale drive before the lift starts up
+	AutoScript *Script;			//thumbwheel 7, from ScriptPath
+	Profile *ScriptPlans[AutoScript::kLayouts];
+	ScriptCommand *ScriptRoutine;	//runs the plan and mechanism commands of this match's layout
+	std::string ScriptPath;
+	int64_t ScriptModified = 0;	//file time of the script last read
+	int ScriptCheckCycles = 0;
 	AHRS *Gyro;
-	Timer *ElapsedTimer;
-	Timer *AutoTimer;
+	RobotIO *IO;
+	RobotIO *HardwareIO;		//IO without the telemetry recorder, for the drive loop
+	SensorSnapshot Sensors;		//this cycle's inputs, from ReadSensors
+	IOTimer *ElapsedTimer;
+	IOTimer *AutoTimer;
+	Odometry *DriveOdometry;
+	Telemetry *Recorder;
+	LoopTiming *LoopProbe;
+	CanScheduler *CanBus = NULL;	//status frame periods and CAN call counts, roboRIO only
+	DriveLoop *Drive = NULL;		//NULL runs the profile inline in the 50Hz loop
+	double DriveLoopRate = 0.0;
+	MotionStreamer *Stream = NULL;	//NULL drives every profile from the RIO
+	bool StreamChecked = false;		//tried to load the current profile into the stream
+	bool Streaming = false;			//the current profile is running on the Talons
+#ifndef ROBOT_SIM
+	Notifier *DriveNotifier = NULL;
+	Notifier *StreamNotifier = NULL;
+#endif
 	//cs::UsbCamera camera;
 	float HeadingOffset = 0.0f;
-	int AutoState = 0;
+	int AutoChoice = 0;		//switch or scale, from GetAutoChoice at AutonomousInit
+	bool AutoComplete = false;
 	int ThumbWheel = 0;
 	std::string GameData;
 	// DistancePerPulse = (1/PulsesPerRevolution) * PI * WheelDiameter
@@ -53,37 +115,84 @@ private:
 	float mag_FeetPerPulse = 0.0008538755; //0.000383495;
 	float wheel_circumference = 1.57079632679; //6 inch wheel
 	double TurnMaxSpeed = 0.5;
+	bool AutoUseSplines = false;	//drive side switch deliveries as one spline instead of MOVE/TURN/MOVE
+	bool AutoStreamMoves = false;	//run MOVE/PAUSE only profiles on the drive Talons' motion profile executers
+	double LoopBudget = 0.010;		//seconds a periodic body may take before it counts as an overrun
 public:
 
 	void RobotInit();
+	//hardware independent setup, called from RobotInit or by the simulator
+	//driveLoopRate in Hz runs the profile and drive in DriveLoopTick, 0 runs them in AutonomousPeriodic
+	void ControlInit(RobotIO *io, double driveLoopRate = 0.0);
+	//one tick of the drive loop, from the Notifier on the roboRIO or stepped by the simulator
+	void DriveLoopTick();
+	//drive loop ticks per 50Hz cycle, 0 when the profile runs inline
+	int GetDriveLoopTicks();
+	//run the profiles the stream can take on the Talons, the stream's fill thread belongs to the caller
+	void AttachStream(MotionStreamer *stream) { Stream = stream; }
+	//record every cycle to a memory mapped file, see Telemetry.h
+	bool OpenTelemetry(const char *path);
+	//record of the last cycle, for the replay tool
+	const TelemetryRecord *GetLastRecord() { return Recorder->Last(); }
 	void AutonomousInit();
 	void AutonomousPeriodic();
 	void TeleopInit();
 	void TeleopPeriodic();
+	void DisabledInit();
 	void DisabledPeriodic();
+	//period and execution time of the periodic functions
+	LoopTiming *GetLoopTiming() { return LoopProbe; }
+	//sample every sensor into Sensors, call first thing in a cycle after the recorder's BeginCycle
+	void ReadSensors();
 	double ffilter(double raw, double current, double lpf);
 	double GetHeading();
 	void ZeroHeading();
 	double GetDistance();
+	void ResetOdometry();
+	void UpdateOdometry();
+	const Pose2d &GetPose();
+	void RecordCycle();
 	int GetThumbWheel();
+	//which plan of a thumbwheel routine the game data calls for
+	int GetAutoChoice(int thumbWheel, const std::string &gameData);
+	//add a routine's steps to an empty plan
+	void BuildPlan(Profile *plan, int thumbWheel, int choice);
+	//build every plan from BaseProfile, again after its gains change
+	void BuildPlans();
+	//build the script's plans, again when it is reloaded
+	void BuildScriptPlans();
+	//drive the side switch deliveries as splines (AutoUseSplines), rebuilds the plans
+	void SetAutoUseSplines(bool use);
+	//track the spline steps with Ramsete (ProfileFollower), turns the splines on, rebuilds the plans
+	void SetAutoFollower(bool follow);
+	//read the thumbwheel 7 script and build its plans, a bad script keeps the last good one
+	//returns the number of commands or -1
+	int LoadScript(const char *path);
+	//load the script again if its file changed, call while disabled
+	void CheckScript();
+	const AutoScript *GetScript() { return Script; }
 	double GetArmSpeed(double stickY, double pos, double pMax, double pMin, double sMax, double sMin);
 	double GetLiftSpeed(double stickX, bool limitLo, bool limitHi);
 	double GetGripSpeed(bool butIntake, bool butReject, double speedFactor);
 	void SetRampRate(double secs);
 
+	//true until the loaded profile has completed
+	bool ProfileRunning();
 	void ExecuteProfile();
+	//take the profile back from the drive loop and the drive back from the stream, call before changing it
+	void StopDriveLoop();
 	void Auto_Drive(double outputMagnitude, double curve);
 	double Clamp(double value, double min, double max);
-	void Auto_Straight();
-	void Auto_SwitchFrom2();
-	void Auto_SwitchOrScaleFrom1();
-	void Auto_SwitchOrScaleFrom3();
-	void Auto_ScaleOrSwitchFrom1();
-	void Auto_ScaleOrSwitchFrom3();
+	//group the autonomous commands into the thumbwheel routines
+	void BuildRoutines();
+	void Auto_Routine();
 	bool EjectCrate(double seconds, double speed);
 	bool LiftRaisedToUpperLimit();
 	bool ArmLowered(double height);
 	bool LiftRaisedToUpperLimitAndArmLowered(double height);
+	//called by each routine when its last step is done
+	void SetAutoComplete();
+	bool IsAutoComplete() { return AutoComplete; }
 };
 
 
@@ -0,0 +1,103 @@
+/*
+ * RobotIO.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Thin sensor/actuator layer between the control code and the hardware.
+ *  Robot, Autonomous and Profile only talk to these interfaces, so the same
+ *  code runs on the roboRIO (FRCRobotIO) or headless on a PC (SimRobotIO).
+ *
+ *  Units are the raw hardware units so both backends return identical values:
+ *     time     microseconds (same as RobotController::GetFPGATime)
+ *     yaw      navX degrees, -180 to 180, clockwise positive
+ *     encoder  CTRE mag encoder counts, in the direction of that side's SetDrive
+ *              output (the Talons' sensor phase), so driving forward counts
+ *              the left side down and the right side up
+ *     arm pot  AnalogPotentiometer scaled value (0-12)
+ *     limits   DigitalInput level (limit switches read false when pressed)
+ *
+ */
+
+#ifndef SRC_ROBOTIO_H_
+#define SRC_ROBOTIO_H_
+
+#include <stdint.h>
+#include <string>
+
+//every sensor the control code uses in a cycle, sampled once at the top of the cycle
+//(the thumbwheel and game data are only read when autonomous starts)
+struct SensorSnapshot
+{
+	uint64_t Time = 0;			//when the sample was taken
+	double Yaw = 0.0;
+	int LeftEncoder = 0;
+	int RightEncoder = 0;
+	double ArmPosition = 0.0;
+	bool LimitLiftHi = true;	//released
+	bool LimitLiftLo = true;
+};
+
+//source of time for everything that used to call RobotController::GetFPGATime()
+class Clock
+{
+public:
+	virtual ~Clock() {}
+	virtual uint64_t GetFPGATime() = 0;
+};
+
+class RobotIO : public Clock
+{
+public:
+	virtual ~RobotIO() {}
+
+	//sensors
+	virtual double GetYaw() = 0;
+	virtual int GetLeftEncoder() = 0;
+	virtual int GetRightEncoder() = 0;
+	virtual void ZeroEncoders() = 0;
+	virtual double GetArmPosition() = 0;
+	virtual bool GetLimitLiftHi() = 0;
+	virtual bool GetLimitLiftLo() = 0;
+	virtual bool GetThumbWheelBit(int bit) = 0;   //bit = 1,2,4 or 8
+	virtual std::string GetGameData() = 0;
+	//all of the above that change during a match, in one pass
+	virtual void ReadSensors(SensorSnapshot *sensors)
+	{
+		sensors->Time = GetFPGATime();
+		sensors->Yaw = GetYaw();
+		sensors->LeftEncoder = GetLeftEncoder();
+		sensors->RightEncoder = GetRightEncoder();
+		sensors->ArmPosition = GetArmPosition();
+		sensors->LimitLiftHi = GetLimitLiftHi();
+		sensors->LimitLiftLo = GetLimitLiftLo();
+	}
+
+	//actuators (-1 to 1, same sign conventions as the speed controllers)
+	virtual void SetDrive(double left, double right) = 0;
+	virtual void SetLift(double speed) = 0;
+	virtual void SetArm(double speed) = 0;
+	virtual void SetGrip(double speed) = 0;
+};
+
+//replacement for frc::Timer driven by a Clock, same HasPeriodPassed semantics
+class IOTimer
+{
+private:
+	Clock *TimerClock;
+	uint64_t StartTime;
+public:
+	IOTimer(Clock *clock) : TimerClock(clock), StartTime(clock->GetFPGATime()) {}
+	void Reset() { StartTime = TimerClock->GetFPGATime(); }
+	double Get() { return (TimerClock->GetFPGATime() - StartTime) / 1000000.0; }
+	bool HasPeriodPassed(double period)
+	{
+		if(Get() > period)
+		{
+			StartTime += uint64_t(period * 1000000.0);
+			return true;
+		}
+		return false;
+	}
+};
+
+#endif /* SRC_ROBOTIO_H_ */
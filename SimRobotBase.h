@@ -0,0 +1,38 @@
+/*
+ * SimRobotBase.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Stand-ins for the WPILib types Robot.h needs when building the headless
+ *  simulator (ROBOT_SIM).  Devices are only held by pointer in Robot, and the
+ *  code that touches them directly is compiled out of the sim build.
+ *
+ */
+
+#ifndef SRC_SIMROBOTBASE_H_
+#define SRC_SIMROBOTBASE_H_
+
+//WPILib.h pulls these in for the roboRIO build
+#include <cmath>
+#include <stdio.h>
+#include <string>
+
+class Joystick;
+class WPI_TalonSRX;
+class VictorSP;
+class AnalogPotentiometer;
+class DifferentialDrive;
+class DigitalInput;
+class AHRS;
+
+namespace frc
+{
+	class TimedRobot
+	{
+	public:
+		virtual ~TimedRobot() {}
+		void SetPeriod(double) {}
+	};
+}
+
+#endif /* SRC_SIMROBOTBASE_H_ */
@@ -0,0 +1,175 @@
+/*
+ * SimRobotIO.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "SimRobotIO.h"
+#include <math.h>
+#include <random>
+
+SimParams PerturbSimParams(uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> slip(0.0,0.08);
+	std::normal_distribution<double> gain(1.0,0.03);
+	std::uniform_real_distribution<double> response(0.8,1.25);
+	std::uniform_real_distribution<double> sag(0.0,0.2);
+	std::normal_distribution<double> drift(0.0,0.05);
+	std::uniform_real_distribution<double> deadband(0.8,1.2);
+	SimParams params;
+	params.LeftSlip = slip(rng);
+	params.RightSlip = slip(rng);
+	params.LeftGain = gain(rng);
+	params.RightGain = gain(rng);
+	params.DriveTimeConstant *= response(rng);
+	params.BatterySag = sag(rng);
+	params.GyroDrift = drift(rng);
+	params.DriveDeadband *= deadband(rng);
+	return params;
+}
+
+SimRobotIO::SimRobotIO()
+{
+	ArmPos = Params.ArmStart;
+}
+
+SimRobotIO::SimRobotIO(const SimParams &params)
+{
+	Reset(params);
+}
+
+void SimRobotIO::Reset(const SimParams &params)
+{
+	Params = params;
+	SimTime = 0;
+	LeftCmd = RightCmd = LiftCmd = ArmCmd = GripCmd = 0.0;
+	LeftSpeed = RightSpeed = 0.0;
+	LeftDist = RightDist = 0.0;
+	LeftZero = RightZero = 0.0;
+	Heading = PosX = PosY = 0.0;
+	LiftPos = 0.0;
+	ArmPos = Params.ArmStart;
+}
+
+void SimRobotIO::Step(double dt)
+{
+	//Robot::Auto_Drive sends the right side negated, both sides drive forward on negative output
+	//the battery sags with the total load on the drive
+	double supply = 1.0 - Params.BatterySag * (fabs(LeftCmd) + fabs(RightCmd)) / 2;
+	double leftTarget = -Deadband(LeftCmd) * Params.MaxWheelSpeed * Params.LeftGain * supply;
+	double rightTarget = Deadband(RightCmd) * Params.MaxWheelSpeed * Params.RightGain * supply;
+	double k = dt / (Params.DriveTimeConstant + dt);
+	LeftSpeed += (leftTarget - LeftSpeed) * k;
+	RightSpeed += (rightTarget - RightSpeed) * k;
+
+	//encoders see the wheels, the robot only moves by what the carpet doesn't take
+	double dLeft = LeftSpeed * dt * (1.0 - Params.LeftSlip);
+	double dRight = RightSpeed * dt * (1.0 - Params.RightSlip);
+	double dCenter = (dLeft + dRight) / 2;
+	double dTheta = (dLeft - dRight) / Params.TrackWidth;	//radians, clockwise
+	double midHeading = Heading * M_PI / 180 + dTheta / 2;
+	PosX += dCenter * cos(midHeading);
+	PosY += dCenter * sin(midHeading);
+	Heading += dTheta * 180 / M_PI;
+	if(Heading > 180) Heading -= 360;
+	if(Heading < -180) Heading += 360;
+	LeftDist += LeftSpeed * dt;
+	RightDist += RightSpeed * dt;
+
+	//negative lift speed raises the lift
+	LiftPos -= LiftCmd * dt / Params.LiftTravelTime;
+	if(LiftPos > 1.0) LiftPos = 1.0;
+	if(LiftPos < 0.0) LiftPos = 0.0;
+
+	ArmPos += ArmCmd * Params.ArmRate * dt;
+	if(ArmPos > 12.0) ArmPos = 12.0;
+	if(ArmPos < 0.0) ArmPos = 0.0;
+
+	SimTime += uint64_t(dt * 1000000.0 + 0.5);
+}
+
+double SimRobotIO::Deadband(double cmd)
+{
+	double mag = (fabs(cmd) - Params.DriveDeadband) / (1.0 - Params.DriveDeadband);
+	if(mag <= 0) return 0.0;
+	if(mag > 1.0) mag = 1.0;
+	return cmd < 0 ? -mag : mag;
+}
+
+uint64_t SimRobotIO::GetFPGATime()
+{
+	return SimTime;
+}
+
+double SimRobotIO::GetYaw()
+{
+	double yaw = Heading + Params.GyroDrift * SimTime / 1000000.0;
+	yaw = remainder(yaw,360.0);
+	return float(yaw);	//navX reports a float
+}
+
+int SimRobotIO::GetLeftEncoder()
+{
+	//the left side drives forward on negative output
+	return int((LeftZero - LeftDist) / Params.FeetPerPulse);
+}
+
+int SimRobotIO::GetRightEncoder()
+{
+	return int((RightDist - RightZero) / Params.FeetPerPulse);
+}
+
+void SimRobotIO::ZeroEncoders()
+{
+	LeftZero = LeftDist;
+	RightZero = RightDist;
+}
+
+double SimRobotIO::GetArmPosition()
+{
+	return ArmPos;
+}
+
+//limit switch inputs read false when pressed
+bool SimRobotIO::GetLimitLiftHi()
+{
+	return LiftPos < 1.0;
+}
+
+bool SimRobotIO::GetLimitLiftLo()
+{
+	return LiftPos > 0.0;
+}
+
+//thumbwheel switch pulls the input low for each bit that is set
+bool SimRobotIO::GetThumbWheelBit(int bit)
+{
+	return (ThumbWheel & bit) == 0;
+}
+
+std::string SimRobotIO::GetGameData()
+{
+	return GameData;
+}
+
+void SimRobotIO::SetDrive(double left, double right)
+{
+	LeftCmd = left;
+	RightCmd = right;
+}
+
+void SimRobotIO::SetLift(double speed)
+{
+	LiftCmd = speed;
+}
+
+void SimRobotIO::SetArm(double speed)
+{
+	ArmCmd = speed;
+}
+
+void SimRobotIO::SetGrip(double speed)
+{
+	GripCmd = speed;
+}
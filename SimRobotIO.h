@@ -0,0 +1,103 @@
+/*
+ * SimRobotIO.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Headless simulation backend for RobotIO.  Models the drivetrain, lift, arm,
+ *  gripper, navX and encoders well enough to run the autonomous code on a PC.
+ *  Time only moves when Step() is called, so a match runs as fast as the CPU allows.
+ *
+ *  Sim frame: x = feet forward from the start, y = feet to the right,
+ *  heading = degrees clockwise (same as navX yaw).
+ *  Encoders count with that side's SetDrive output like the Talons' sensors
+ *  (RobotIO.h), so driving forward counts the left down and the right up.
+ *
+ */
+
+#ifndef SRC_SIMROBOTIO_H_
+#define SRC_SIMROBOTIO_H_
+
+#include "RobotIO.h"
+
+struct SimParams
+{
+	double MaxWheelSpeed = 12.0;		//ft/s at full output
+	double DriveTimeConstant = 0.15;	//seconds, first order motor response
+	double DriveDeadband = 0.1;			//output needed to overcome friction
+	double TrackWidth = 2.0;			//feet between left and right wheels
+	double FeetPerPulse = 0.0008538755;	//must match Robot::mag_FeetPerPulse
+	double LiftTravelTime = 1.5;		//seconds from bottom to top at full speed
+	double ArmRate = 4.0;				//pot units per second at full speed
+	double ArmStart = 8.0;				//arm pot reading at power up
+	//disturbances, the defaults are an ideal robot
+	double LeftSlip = 0.0;				//fraction of wheel travel lost to the carpet
+	double RightSlip = 0.0;
+	double LeftGain = 1.0;				//motor strength relative to nominal
+	double RightGain = 1.0;
+	double BatterySag = 0.0;			//fraction of speed lost at full output on both sides
+	double GyroDrift = 0.0;				//degrees per second added to the navX yaw
+};
+
+//a randomly disturbed robot (slip, gyro drift, motor response and strength,
+//battery sag), the same seed always gives the same robot
+SimParams PerturbSimParams(uint32_t seed);
+
+class SimRobotIO : public RobotIO
+{
+private:
+	SimParams Params;
+	uint64_t SimTime = 0;
+	double LeftCmd = 0.0;
+	double RightCmd = 0.0;
+	double LiftCmd = 0.0;
+	double ArmCmd = 0.0;
+	double GripCmd = 0.0;
+	double LeftSpeed = 0.0;
+	double RightSpeed = 0.0;
+	double LeftDist = 0.0;
+	double RightDist = 0.0;
+	double LeftZero = 0.0;
+	double RightZero = 0.0;
+	double Heading = 0.0;
+	double PosX = 0.0;
+	double PosY = 0.0;
+	double LiftPos = 0.0;		//0 = bottom, 1 = top
+	double ArmPos;
+	int ThumbWheel = 0;
+	std::string GameData;
+
+	double Deadband(double cmd);
+public:
+	SimRobotIO();
+	SimRobotIO(const SimParams &params);
+	//back to power up with new parameters, keeps thumbwheel and game data
+	void Reset(const SimParams &params);
+
+	//advance the simulation by dt seconds
+	void Step(double dt);
+	void SetThumbWheel(int value) { ThumbWheel = value; }
+	void SetGameData(const std::string &data) { GameData = data; }
+	double GetX() { return PosX; }
+	double GetY() { return PosY; }
+	double GetHeading() { return Heading; }
+	double GetLiftPosition() { return LiftPos; }
+	double GetGripSpeed() { return GripCmd; }
+
+	uint64_t GetFPGATime();
+	double GetYaw();
+	int GetLeftEncoder();
+	int GetRightEncoder();
+	void ZeroEncoders();
+	double GetArmPosition();
+	bool GetLimitLiftHi();
+	bool GetLimitLiftLo();
+	bool GetThumbWheelBit(int bit);
+	std::string GetGameData();
+
+	void SetDrive(double left, double right);
+	void SetLift(double speed);
+	void SetArm(double speed);
+	void SetGrip(double speed);
+};
+
+#endif /* SRC_SIMROBOTIO_H_ */
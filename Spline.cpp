@@ -0,0 +1,180 @@
+/*
+ * Spline.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Spline.h"
+#include <math.h>
+
+//one quintic Hermite segment with zero second derivative at both ends
+struct HermiteSegment
+{
+	double X0, Y0, DX0, DY0, X1, Y1, DX1, DY1;
+
+	void Set(const Waypoint &a, const Waypoint &b)
+	{
+		double scale = sqrt((b.X - a.X) * (b.X - a.X) + (b.Y - a.Y) * (b.Y - a.Y));
+		X0 = a.X; Y0 = a.Y;
+		X1 = b.X; Y1 = b.Y;
+		DX0 = scale * cos(a.Heading * M_PI / 180);
+		DY0 = scale * sin(a.Heading * M_PI / 180);
+		DX1 = scale * cos(b.Heading * M_PI / 180);
+		DY1 = scale * sin(b.Heading * M_PI / 180);
+	}
+
+	void Evaluate(double u, double *x, double *y, double *dx, double *dy, double *ddx, double *ddy) const
+	{
+		double u2 = u * u, u3 = u2 * u, u4 = u3 * u, u5 = u4 * u;
+		double h0 = 1 - 10 * u3 + 15 * u4 - 6 * u5;
+		double h1 = u - 6 * u3 + 8 * u4 - 3 * u5;
+		double h4 = -4 * u3 + 7 * u4 - 3 * u5;
+		double h5 = 10 * u3 - 15 * u4 + 6 * u5;
+		double d0 = -30 * u2 + 60 * u3 - 30 * u4;
+		double d1 = 1 - 18 * u2 + 32 * u3 - 15 * u4;
+		double d4 = -12 * u2 + 28 * u3 - 15 * u4;
+		double d5 = 30 * u2 - 60 * u3 + 30 * u4;
+		double dd0 = -60 * u + 180 * u2 - 120 * u3;
+		double dd1 = -36 * u + 96 * u2 - 60 * u3;
+		double dd4 = -24 * u + 84 * u2 - 60 * u3;
+		double dd5 = 60 * u - 180 * u2 + 120 * u3;
+		*x = h0 * X0 + h1 * DX0 + h4 * DX1 + h5 * X1;
+		*y = h0 * Y0 + h1 * DY0 + h4 * DY1 + h5 * Y1;
+		*dx = d0 * X0 + d1 * DX0 + d4 * DX1 + d5 * X1;
+		*dy = d0 * Y0 + d1 * DY0 + d4 * DY1 + d5 * Y1;
+		*ddx = dd0 * X0 + dd1 * DX0 + dd4 * DX1 + dd5 * X1;
+		*ddy = dd0 * Y0 + dd1 * DY0 + dd4 * DY1 + dd5 * Y1;
+	}
+};
+
+//walk the splines in small parameter steps and keep a point every ds of arc length
+double SplineGenerator::Resample(const Waypoint *waypoints, int count, double ds)
+{
+	HermiteSegment seg;
+	double x, y, dx, dy, ddx, ddy;
+	double length = 0.0;
+
+	for(int i = 0; i < count - 1; i++)
+	{
+		seg.Set(waypoints[i],waypoints[i+1]);
+		for(int k = 0; k < kSubSteps; k++)
+		{
+			seg.Evaluate((k + 0.5) / kSubSteps,&x,&y,&dx,&dy,&ddx,&ddy);
+			length += sqrt(dx * dx + dy * dy) / kSubSteps;
+		}
+	}
+	if(length / ds > kMaxPoints - 1) ds = length / (kMaxPoints - 1);
+
+	double s = 0.0, nextS = 0.0, lastHeading = 0.0;
+	PathPoints = 0;
+	for(int i = 0; i < count - 1 && PathPoints < kMaxPoints; i++)
+	{
+		seg.Set(waypoints[i],waypoints[i+1]);
+		for(int k = 0; k <= kSubSteps && PathPoints < kMaxPoints; k++)
+		{
+			double u = double(k) / kSubSteps;
+			seg.Evaluate(u,&x,&y,&dx,&dy,&ddx,&ddy);
+			double speed = sqrt(dx * dx + dy * dy);
+			bool last = (i == count - 2 && k == kSubSteps);
+			if(s >= nextS || last)
+			{
+				double heading = atan2(dy,dx) * 180 / M_PI;
+				//unwrap so the heading is continuous along the path
+				if(PathPoints > 0)
+				{
+					while(heading - lastHeading > 180) heading -= 360;
+					while(heading - lastHeading < -180) heading += 360;
+				}
+				lastHeading = heading;
+				PathS[PathPoints] = last ? length : nextS;
+				PathX[PathPoints] = x;
+				PathY[PathPoints] = y;
+				PathHeading[PathPoints] = heading;
+				PathCurvature[PathPoints] = speed > 0 ? (dx * ddy - dy * ddx) / (speed * speed * speed) : 0.0;
+				PathPoints++;
+				nextS += ds;
+				if(last) break;
+			}
+			if(k < kSubSteps) s += speed / kSubSteps;
+		}
+	}
+	return ds;
+}
+
+//fastest speed at each point for the wheels and lateral acceleration, stopped at both ends
+void SplineGenerator::PlanVelocity(const PathLimits &limits)
+{
+	PlanPathVelocity(PathS,PathCurvature,PathPoints,limits,0.0,0.0,PathVelocity);
+
+	PathTime[0] = 0.0;
+	PathWheel[0] = 0.0;
+	for(int i = 1; i < PathPoints; i++)
+	{
+		double stepDs = PathS[i] - PathS[i-1];
+		double vSum = PathVelocity[i-1] + PathVelocity[i];
+		PathTime[i] = PathTime[i-1] + (vSum > 0 ? 2 * stepDs / vSum : 0.0);
+		double k = (PathCurvature[i-1] + PathCurvature[i]) / 2;
+		PathWheel[i] = PathWheel[i-1] + stepDs * (1 - k * limits.TrackWidth / 2);
+	}
+}
+
+int SplineGenerator::Generate(const Waypoint *waypoints, int count, const PathLimits &limits,
+		double dt, PathSample *samples, int maxSamples, double *sampleDt)
+{
+	if(count < 2 || maxSamples < 2 || limits.MaxVelocity <= 0 || limits.MaxAccel <= 0) return 0;
+	Resample(waypoints,count,0.05);
+	if(PathPoints < 2) return 0;
+	PlanVelocity(limits);
+
+	double duration = PathTime[PathPoints-1];
+	int sampleCount = int(ceil(duration / dt)) + 1;
+	if(sampleCount > maxSamples)
+	{
+		sampleCount = maxSamples;
+		dt = duration / (sampleCount - 1);
+	}
+	*sampleDt = dt;
+
+	int i = 0;
+	for(int n = 0; n < sampleCount; n++)
+	{
+		double t = n * dt;
+		if(t > duration) t = duration;
+		while(i < PathPoints - 2 && PathTime[i+1] < t) i++;
+		double span = PathTime[i+1] - PathTime[i];
+		double f = span > 0 ? (t - PathTime[i]) / span : 0.0;
+		PathSample &p = samples[n];
+		p.Time = t;
+		p.Distance = PathS[i] + (PathS[i+1] - PathS[i]) * f;
+		p.WheelDistance = PathWheel[i] + (PathWheel[i+1] - PathWheel[i]) * f;
+		p.Velocity = PathVelocity[i] + (PathVelocity[i+1] - PathVelocity[i]) * f;
+		p.Accel = span > 0 ? (PathVelocity[i+1] - PathVelocity[i]) / span : 0.0;
+		p.X = PathX[i] + (PathX[i+1] - PathX[i]) * f;
+		p.Y = PathY[i] + (PathY[i+1] - PathY[i]) * f;
+		p.Heading = PathHeading[i] + (PathHeading[i+1] - PathHeading[i]) * f;
+		p.Curvature = PathCurvature[i] + (PathCurvature[i+1] - PathCurvature[i]) * f;
+	}
+	return sampleCount;
+}
+
+PathSample LookupPath(const PathSample *samples, int count, double dt, double t)
+{
+	if(count <= 0) return PathSample();
+	if(t <= 0.0) return samples[0];
+	int i = int(t / dt);
+	if(i >= count - 1) return samples[count - 1];
+	const PathSample &a = samples[i];
+	const PathSample &b = samples[i + 1];
+	double f = (t - a.Time) / dt;
+	PathSample out;
+	out.Time = t;
+	out.Distance = a.Distance + (b.Distance - a.Distance) * f;
+	out.WheelDistance = a.WheelDistance + (b.WheelDistance - a.WheelDistance) * f;
+	out.Velocity = a.Velocity + (b.Velocity - a.Velocity) * f;
+	out.Accel = a.Accel + (b.Accel - a.Accel) * f;
+	out.X = a.X + (b.X - a.X) * f;
+	out.Y = a.Y + (b.Y - a.Y) * f;
+	out.Heading = a.Heading + (b.Heading - a.Heading) * f;
+	out.Curvature = a.Curvature + (b.Curvature - a.Curvature) * f;
+	return out;
+}
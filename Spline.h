@@ -0,0 +1,69 @@
+/*
+ * Spline.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Quintic Hermite spline paths through waypoints with headings.
+ *  The path is resampled at even arc length, given the fastest speed the
+ *  wheels and the lateral acceleration allow (VelocityPlanner.h), then
+ *  sampled in time for O(1) lookup.
+ *
+ *  Frame is the robot at the start of the step: X feet forward, Y feet to the
+ *  right, Heading degrees clockwise (same sense as the navX).  Curvature is
+ *  positive turning right.
+ *
+ */
+
+#ifndef SRC_SPLINE_H_
+#define SRC_SPLINE_H_
+
+#include "VelocityPlanner.h"
+
+struct Waypoint
+{
+	double X = 0.0;
+	double Y = 0.0;
+	double Heading = 0.0;
+};
+
+struct PathSample
+{
+	double Time = 0.0;
+	double Distance = 0.0;		//along the center of the robot
+	double WheelDistance = 0.0;	//travelled by the right wheels
+	double Velocity = 0.0;
+	double Accel = 0.0;
+	double X = 0.0;
+	double Y = 0.0;
+	double Heading = 0.0;		//unwrapped, may go past 360
+	double Curvature = 0.0;
+};
+
+class SplineGenerator
+{
+private:
+	static const int kMaxPoints = 2048;
+	static const int kSubSteps = 1000;	//parameter steps per spline segment when measuring
+	double PathS[kMaxPoints];
+	double PathX[kMaxPoints];
+	double PathY[kMaxPoints];
+	double PathHeading[kMaxPoints];
+	double PathCurvature[kMaxPoints];
+	double PathVelocity[kMaxPoints];
+	double PathTime[kMaxPoints];
+	double PathWheel[kMaxPoints];
+	int PathPoints = 0;
+
+	double Resample(const Waypoint *waypoints, int count, double ds);
+	void PlanVelocity(const PathLimits &limits);
+public:
+	//build the path and fill samples every dt (stretched if the table would overflow)
+	//returns the number of samples, 0 if the waypoints are unusable
+	int Generate(const Waypoint *waypoints, int count, const PathLimits &limits,
+			double dt, PathSample *samples, int maxSamples, double *sampleDt);
+};
+
+//interpolated sample at time t, holds the last sample after the end of the table
+PathSample LookupPath(const PathSample *samples, int count, double dt, double t);
+
+#endif /* SRC_SPLINE_H_ */
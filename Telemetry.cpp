@@ -0,0 +1,245 @@
+/*
+ * Telemetry.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Telemetry.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define TELEMETRY_FIELD(name,type) {#name,type,offsetof(TelemetryRecord,name)}
+
+static const TelemetryField RecordFields[] =
+{
+	TELEMETRY_FIELD(Time,kTelemetryU64),
+	TELEMETRY_FIELD(Yaw,kTelemetryF64),
+	TELEMETRY_FIELD(LeftEncoder,kTelemetryI32),
+	TELEMETRY_FIELD(RightEncoder,kTelemetryI32),
+	TELEMETRY_FIELD(ArmPosition,kTelemetryF64),
+	TELEMETRY_FIELD(LimitLiftHi,kTelemetryU8),
+	TELEMETRY_FIELD(LimitLiftLo,kTelemetryU8),
+	TELEMETRY_FIELD(Mode,kTelemetryU8),
+	TELEMETRY_FIELD(AutoState,kTelemetryU8),
+	TELEMETRY_FIELD(ProfileStep,kTelemetryI32),
+	TELEMETRY_FIELD(Heading,kTelemetryF64),
+	TELEMETRY_FIELD(Distance,kTelemetryF64),
+	TELEMETRY_FIELD(PoseX,kTelemetryF64),
+	TELEMETRY_FIELD(PoseY,kTelemetryF64),
+	TELEMETRY_FIELD(PoseHeading,kTelemetryF64),
+	TELEMETRY_FIELD(OutputMagnitude,kTelemetryF32),
+	TELEMETRY_FIELD(Curve,kTelemetryF32),
+	TELEMETRY_FIELD(SteerP,kTelemetryF64),
+	TELEMETRY_FIELD(SteerI,kTelemetryF64),
+	TELEMETRY_FIELD(SteerD,kTelemetryF64),
+	TELEMETRY_FIELD(TurnP,kTelemetryF64),
+	TELEMETRY_FIELD(TurnI,kTelemetryF64),
+	TELEMETRY_FIELD(TurnD,kTelemetryF64),
+	TELEMETRY_FIELD(DriveLeft,kTelemetryF64),
+	TELEMETRY_FIELD(DriveRight,kTelemetryF64),
+	TELEMETRY_FIELD(Lift,kTelemetryF64),
+	TELEMETRY_FIELD(Arm,kTelemetryF64),
+	TELEMETRY_FIELD(Grip,kTelemetryF64),
+};
+
+static const int kRecordFieldCount = sizeof(RecordFields) / sizeof(RecordFields[0]);
+static_assert(kRecordFieldCount <= TelemetryHeader::kMaxFields,"too many telemetry fields");
+
+int Telemetry::GetSchema(const TelemetryField **fields)
+{
+	*fields = RecordFields;
+	return kRecordFieldCount;
+}
+
+Telemetry::Telemetry()
+{
+	memset(Scratch,0,sizeof(Scratch));
+	memset(&Outside,0,sizeof(Outside));
+}
+
+Telemetry::~Telemetry()
+{
+	Close();
+}
+
+bool Telemetry::Open(const char *path, uint32_t capacity)
+{
+	Close();
+	MapSize = sizeof(TelemetryHeader) + size_t(capacity) * sizeof(TelemetryRecord);
+	FileDescriptor = open(path,O_RDWR | O_CREAT | O_TRUNC,0644);
+	if(FileDescriptor < 0)
+	{
+		printf("[Telemetry] could not open %s\n",path);
+		return false;
+	}
+	//reserve the blocks now so the loop never waits on the filesystem
+	if(posix_fallocate(FileDescriptor,0,MapSize) != 0 && ftruncate(FileDescriptor,MapSize) != 0)
+	{
+		printf("[Telemetry] could not size %s\n",path);
+		Close();
+		return false;
+	}
+	int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+	flags |= MAP_POPULATE;	//fault the pages in now instead of in the loop
+#endif
+	void *map = mmap(NULL,MapSize,PROT_READ | PROT_WRITE,flags,FileDescriptor,0);
+	if(map == MAP_FAILED)
+	{
+		printf("[Telemetry] could not map %s\n",path);
+		Close();
+		return false;
+	}
+	Header = (TelemetryHeader *)map;
+	Records = (TelemetryRecord *)((char *)map + sizeof(TelemetryHeader));
+	memset(Header,0,sizeof(TelemetryHeader));
+	strncpy(Header->Magic,"FRCTLM1",sizeof(Header->Magic));
+	Header->HeaderSize = sizeof(TelemetryHeader);
+	Header->RecordSize = sizeof(TelemetryRecord);
+	Header->FieldCount = kRecordFieldCount;
+	Header->Capacity = capacity;
+	memcpy(Header->Fields,RecordFields,sizeof(RecordFields));
+	Record = &Outside;
+	LastRecord = &Outside;
+	return true;
+}
+
+void Telemetry::Close()
+{
+	if(Header != NULL)
+	{
+		msync(Header,MapSize,MS_SYNC);
+		munmap(Header,MapSize);
+	}
+	if(FileDescriptor >= 0) close(FileDescriptor);
+	Header = NULL;
+	Records = NULL;
+	Record = &Outside;
+	LastRecord = &Outside;
+	InCycle = false;
+	FileDescriptor = -1;
+	MapSize = 0;
+}
+
+void Telemetry::SetMatch(const std::string &gameData, int thumbWheel, double driveLoopRate)
+{
+	if(Header == NULL) return;
+	memset(Header->GameData,0,sizeof(Header->GameData));
+	strncpy(Header->GameData,gameData.c_str(),sizeof(Header->GameData) - 1);
+	Header->ThumbWheel = thumbWheel;
+	Header->DriveLoopRate = uint32_t(driveLoopRate);
+	Header->ScriptHash = 0;
+	memset(Header->ScriptPath,0,sizeof(Header->ScriptPath));
+	Header->RecordCount = 0;
+}
+
+void Telemetry::SetScript(uint32_t hash, const std::string &path)
+{
+	if(Header == NULL) return;
+	Header->ScriptHash = hash;
+	memset(Header->ScriptPath,0,sizeof(Header->ScriptPath));
+	strncpy(Header->ScriptPath,path.c_str(),sizeof(Header->ScriptPath) - 1);
+}
+
+void Telemetry::BeginCycle(uint64_t time, TelemetryMode mode)
+{
+	if(Header != NULL) Record = &Records[Header->RecordCount % Header->Capacity];
+	else Record = &Scratch[Cycles & 1];
+	memset(Record,0,sizeof(TelemetryRecord));
+	Record->Time = time;
+	Record->Mode = mode;
+	InCycle = true;
+	CycleReads = 0;
+}
+
+void Telemetry::Commit()
+{
+	if(Header != NULL) Header->RecordCount++;
+	LastRecord = Record;
+	Cycles++;
+	InCycle = false;
+	Record = &Outside;	//reads outside a cycle don't touch the published record
+}
+
+uint64_t TelemetryRobotIO::GetFPGATime()
+{
+	if(Recorder->IsInCycle()) return Recorder->Current()->Time;
+	return IO->GetFPGATime();
+}
+
+double TelemetryRobotIO::GetYaw()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	if(!Recorder->Latch(kReadYaw)) rec->Yaw = IO->GetYaw();
+	return rec->Yaw;
+}
+
+int TelemetryRobotIO::GetLeftEncoder()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	if(!Recorder->Latch(kReadLeftEncoder)) rec->LeftEncoder = IO->GetLeftEncoder();
+	return rec->LeftEncoder;
+}
+
+int TelemetryRobotIO::GetRightEncoder()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	if(!Recorder->Latch(kReadRightEncoder)) rec->RightEncoder = IO->GetRightEncoder();
+	return rec->RightEncoder;
+}
+
+void TelemetryRobotIO::ZeroEncoders()
+{
+	IO->ZeroEncoders();
+	Recorder->Unlatch(kReadLeftEncoder | kReadRightEncoder);
+}
+
+double TelemetryRobotIO::GetArmPosition()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	if(!Recorder->Latch(kReadArm)) rec->ArmPosition = IO->GetArmPosition();
+	return rec->ArmPosition;
+}
+
+bool TelemetryRobotIO::GetLimitLiftHi()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	if(!Recorder->Latch(kReadLiftHi)) rec->LimitLiftHi = IO->GetLimitLiftHi();
+	return rec->LimitLiftHi;
+}
+
+bool TelemetryRobotIO::GetLimitLiftLo()
+{
+	TelemetryRecord *rec = Recorder->Current();
+	if(!Recorder->Latch(kReadLiftLo)) rec->LimitLiftLo = IO->GetLimitLiftLo();
+	return rec->LimitLiftLo;
+}
+
+void TelemetryRobotIO::SetDrive(double left, double right)
+{
+	TelemetryRecord *rec = Recorder->Current();
+	rec->DriveLeft = left;
+	rec->DriveRight = right;
+	IO->SetDrive(left,right);
+}
+
+void TelemetryRobotIO::SetLift(double speed)
+{
+	Recorder->Current()->Lift = speed;
+	IO->SetLift(speed);
+}
+
+void TelemetryRobotIO::SetArm(double speed)
+{
+	Recorder->Current()->Arm = speed;
+	IO->SetArm(speed);
+}
+
+void TelemetryRobotIO::SetGrip(double speed)
+{
+	Recorder->Current()->Grip = speed;
+	IO->SetGrip(speed);
+}
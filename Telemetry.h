@@ -0,0 +1,165 @@
+/*
+ * Telemetry.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Per cycle match recorder.  The file is sized and mapped once by Open,
+ *  each cycle the control code fills the next record in place through
+ *  Current() and Commit() bumps the record count in the header.  Nothing is
+ *  copied or written with a system call in the loop, the kernel writes the
+ *  mapped pages back to the file.
+ *
+ *  The file starts with a TelemetryHeader that describes every record field
+ *  (name, type, offset) so tools can read it without this header file.  The
+ *  records are a ring, record n is at n % Capacity.
+ *
+ */
+
+#ifndef SRC_TELEMETRY_H_
+#define SRC_TELEMETRY_H_
+
+#include "RobotIO.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+typedef enum {kTelemetryU8,kTelemetryI32,kTelemetryU64,kTelemetryF32,kTelemetryF64} TelemetryType;
+typedef enum {kModeDisabled,kModeAutonomous,kModeTeleop,kModeAutonomousInit} TelemetryMode;
+//sensors latched in the current cycle
+typedef enum {kReadYaw = 1,kReadLeftEncoder = 2,kReadRightEncoder = 4,kReadArm = 8,kReadLiftHi = 16,kReadLiftLo = 32} TelemetryRead;
+
+struct TelemetryRecord
+{
+	uint64_t Time;			//FPGA microseconds at the start of the cycle
+	//raw sensors as the control code read them
+	double Yaw;
+	int32_t LeftEncoder;
+	int32_t RightEncoder;
+	double ArmPosition;
+	uint8_t LimitLiftHi;
+	uint8_t LimitLiftLo;
+	uint8_t Mode;
+	uint8_t AutoState;	//step of the autonomous routine, Command::GetStep
+	int32_t ProfileStep;
+	//profile inputs
+	double Heading;
+	double Distance;
+	double PoseX;
+	double PoseY;
+	double PoseHeading;
+	//profile outputs and loop terms
+	float OutputMagnitude;
+	float Curve;
+	double SteerP;
+	double SteerI;
+	double SteerD;
+	double TurnP;
+	double TurnI;
+	double TurnD;
+	//commands sent through RobotIO
+	double DriveLeft;
+	double DriveRight;
+	double Lift;
+	double Arm;
+	double Grip;
+};
+
+struct TelemetryField
+{
+	char Name[20];
+	uint16_t Type;
+	uint16_t Offset;
+};
+
+struct TelemetryHeader
+{
+	static const int kMaxFields = 48;
+	char Magic[8];			//"FRCTLM1"
+	uint32_t HeaderSize;
+	uint32_t RecordSize;
+	uint32_t FieldCount;
+	uint32_t Capacity;
+	uint64_t RecordCount;	//records written, the newest is (RecordCount - 1) % Capacity
+	char GameData[8];
+	int32_t ThumbWheel;
+	uint32_t DriveLoopRate;	//Hz, 0 when the profile ran in the 50Hz cycle
+	uint32_t ScriptHash;	//AutoScript::GetHash of a thumbwheel 7 run, 0 otherwise
+	char ScriptPath[64];	//where that script was loaded from
+	TelemetryField Fields[kMaxFields];
+};
+
+class Telemetry
+{
+private:
+	TelemetryHeader *Header = NULL;
+	TelemetryRecord *Records = NULL;
+	TelemetryRecord Scratch[2];		//filled instead of the file when none is open
+	TelemetryRecord Outside;		//takes reads and commands between cycles
+	TelemetryRecord *Record = &Outside;
+	const TelemetryRecord *LastRecord = &Outside;
+	uint64_t Cycles = 0;
+	bool InCycle = false;
+	uint32_t CycleReads = 0;
+	size_t MapSize = 0;
+	int FileDescriptor = -1;
+public:
+	Telemetry();
+	~Telemetry();
+	//create or overwrite the file sized for capacity records and map it
+	bool Open(const char *path, uint32_t capacity);
+	void Close();
+	bool IsOpen() const { return Header != NULL; }
+	//the record layout written to the header, for tools checking a file
+	static int GetSchema(const TelemetryField **fields);
+	//start of a match, restarts the ring
+	void SetMatch(const std::string &gameData, int thumbWheel, double driveLoopRate);
+	//the script a match runs, after SetMatch
+	void SetScript(uint32_t hash, const std::string &path);
+	//clear the next record and make it current
+	void BeginCycle(uint64_t time, TelemetryMode mode);
+	TelemetryRecord *Current() { return Record; }
+	//publish the current record
+	void Commit();
+	//the record from the last Commit, valid until the next BeginCycle
+	const TelemetryRecord *Last() const { return LastRecord; }
+	bool IsInCycle() const { return InCycle; }
+	//true if the sensor was already read this cycle, marks it read
+	bool Latch(TelemetryRead sensor)
+	{
+		bool latched = InCycle && (CycleReads & sensor);
+		CycleReads |= sensor;
+		return latched;
+	}
+	void Unlatch(uint32_t sensors) { CycleReads &= ~sensors; }
+};
+
+//RobotIO that stores every value read and every command sent in the current record.
+//Inside a cycle the clock is the cycle's time and each sensor is read from the
+//hardware once, later reads return the stored value, so a cycle sees consistent
+//inputs and a replay of the record reproduces it exactly.
+class TelemetryRobotIO : public RobotIO
+{
+private:
+	RobotIO *IO;
+	Telemetry *Recorder;
+public:
+	TelemetryRobotIO(RobotIO *io, Telemetry *recorder) : IO(io), Recorder(recorder) {}
+
+	uint64_t GetFPGATime();
+	double GetYaw();
+	int GetLeftEncoder();
+	int GetRightEncoder();
+	void ZeroEncoders();
+	double GetArmPosition();
+	bool GetLimitLiftHi();
+	bool GetLimitLiftLo();
+	bool GetThumbWheelBit(int bit) { return IO->GetThumbWheelBit(bit); }
+	std::string GetGameData() { return IO->GetGameData(); }
+
+	void SetDrive(double left, double right);
+	void SetLift(double speed);
+	void SetArm(double speed);
+	void SetGrip(double speed);
+};
+
+#endif /* SRC_TELEMETRY_H_ */
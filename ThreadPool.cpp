@@ -0,0 +1,95 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads) : NextQueue(0), Queued(0), Pending(0)
+{
+	if(threads <= 0) threads = std::thread::hardware_concurrency();
+	if(threads <= 0) threads = 1;
+	ThreadCount = threads;
+	Queues.reset(new WorkerQueue[threads]);
+	Threads.reserve(threads);
+	for(int i = 0; i < threads; i++) Threads.emplace_back(&ThreadPool::Run,this,i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(StateLock);
+		Stopping = true;
+	}
+	WorkReady.notify_all();
+	for(std::thread &thread : Threads) thread.join();
+}
+
+void ThreadPool::Submit(Task task)
+{
+	int ndx = NextQueue++ % ThreadCount;
+	Pending++;
+	{
+		std::lock_guard<std::mutex> lock(Queues[ndx].Lock);
+		Queues[ndx].Tasks.push_back(std::move(task));
+	}
+	{
+		//under the lock so a worker about to sleep can't miss it
+		std::lock_guard<std::mutex> lock(StateLock);
+		Queued++;
+	}
+	WorkReady.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(StateLock);
+	AllDone.wait(lock,[this]() { return Pending == 0; });
+}
+
+bool ThreadPool::TryGet(int worker, Task &task)
+{
+	int count = ThreadCount;
+	//own queue from the back, the rest from the front
+	for(int i = 0; i < count; i++)
+	{
+		WorkerQueue &queue = Queues[(worker + i) % count];
+		std::lock_guard<std::mutex> lock(queue.Lock);
+		if(queue.Tasks.empty()) continue;
+		if(i == 0)
+		{
+			task = std::move(queue.Tasks.back());
+			queue.Tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(queue.Tasks.front());
+			queue.Tasks.pop_front();
+		}
+		Queued--;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::Run(int worker)
+{
+	for(;;)
+	{
+		Task task;
+		if(TryGet(worker,task))
+		{
+			task(worker);
+			if(--Pending == 0)
+			{
+				std::lock_guard<std::mutex> lock(StateLock);
+				AllDone.notify_all();
+			}
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(StateLock);
+		WorkReady.wait(lock,[this]() { return Stopping || Queued > 0; });
+		if(Stopping && Queued == 0) return;
+	}
+}
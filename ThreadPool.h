@@ -0,0 +1,62 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Work stealing thread pool for the batch sim tools.  Each worker has its
+ *  own queue: Submit deals tasks round robin, a worker runs its own newest
+ *  task first and when it runs dry steals the oldest task from another
+ *  worker, so uneven tasks (a 3 second auto next to a 15 second one) still
+ *  keep every core busy.  Tasks get the index of the worker running them so
+ *  they can use per worker state without locking.
+ *
+ */
+
+#ifndef SRC_THREADPOOL_H_
+#define SRC_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	typedef std::function<void(int worker)> Task;
+
+	//threads = 0 uses one per hardware thread
+	ThreadPool(int threads = 0);
+	~ThreadPool();
+	int GetThreadCount() const { return ThreadCount; }
+	void Submit(Task task);
+	//block until every submitted task has finished
+	void Wait();
+
+private:
+	struct WorkerQueue
+	{
+		std::mutex Lock;
+		std::deque<Task> Tasks;
+	};
+
+	int ThreadCount;				//fixed before any worker starts
+	std::vector<std::thread> Threads;
+	std::unique_ptr<WorkerQueue[]> Queues;
+	std::atomic<unsigned> NextQueue;
+	std::atomic<int> Queued;		//tasks sitting in queues
+	std::atomic<int> Pending;		//tasks submitted and not finished
+	std::mutex StateLock;
+	std::condition_variable WorkReady;
+	std::condition_variable AllDone;
+	bool Stopping = false;
+
+	bool TryGet(int worker, Task &task);
+	void Run(int worker);
+};
+
+#endif /* SRC_THREADPOOL_H_ */
@@ -0,0 +1,24 @@
+/*
+ * Trajectory.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Trajectory.h"
+
+TrajectorySample LookupTrajectory(const TrajectorySample *samples, int count, double dt, double t)
+{
+	if(count <= 0) return TrajectorySample();
+	if(t <= 0.0) return samples[0];
+	int i = int(t / dt);
+	if(i >= count - 1) return samples[count - 1];
+	const TrajectorySample &a = samples[i];
+	const TrajectorySample &b = samples[i + 1];
+	double f = (t - a.Time) / dt;
+	TrajectorySample out;
+	out.Time = t;
+	out.Position = a.Position + (b.Position - a.Position) * f;
+	out.Velocity = a.Velocity + (b.Velocity - a.Velocity) * f;
+	out.Accel = a.Accel + (b.Accel - a.Accel) * f;
+	return out;
+}
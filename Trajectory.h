@@ -0,0 +1,313 @@
+/*
+ * Trajectory.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Time parameterized motion profiles for straight line moves.
+ *  Trapezoid (MaxJerk = 0) or jerk limited 7 segment S-curve (MaxJerk > 0).
+ *  A move is planned once into a short list of constant jerk segments, then
+ *  sampled into a table of (t, position, velocity, acceleration) at a fixed dt.
+ *  At run time LookupTrajectory is an O(1) indexed and interpolated read.
+ *
+ *  Units are feet, seconds, ft/s and ft/s^2.  Distances are always positive,
+ *  direction is handled by the caller.
+ *
+ *  Planning and sampling are constexpr so a move known when the code is
+ *  written can be tabled by the compiler (MakeTrajectoryTable) into read only
+ *  data.  The robot plans at run time with the same functions, so the tables
+ *  match what Profile::AddMove would build to the last bit.
+ *
+ */
+
+#ifndef SRC_TRAJECTORY_H_
+#define SRC_TRAJECTORY_H_
+
+struct TrajectorySample
+{
+	double Time = 0.0;
+	double Position = 0.0;
+	double Velocity = 0.0;
+	double Accel = 0.0;
+};
+
+struct MotionLimits
+{
+	double StartVelocity = 0.0;
+	double EndVelocity = 0.0;
+	double MaxVelocity = 0.0;
+	double MaxAccel = 0.0;
+	double MaxJerk = 0.0;		//0 = trapezoid
+};
+
+//one piece of the profile with constant jerk, Accel is the acceleration at its start
+struct TrajectorySegment
+{
+	double Duration = 0.0;
+	double Jerk = 0.0;
+	double Accel = 0.0;
+};
+
+struct TrajectoryPlan
+{
+	TrajectorySegment Segments[7];
+	int SegmentCount = 0;
+	double StartVelocity = 0.0;
+	double EndVelocity = 0.0;
+	double Distance = 0.0;
+	double Duration = 0.0;
+};
+
+//math.h functions are not constexpr, these give the same results for the values planning uses
+constexpr double TrajectoryAbs(double x) { return x < 0 ? -x : x; }
+constexpr double TrajectoryMax(double a, double b) { return a > b ? a : b; }
+
+//correctly rounded like sqrt(), 0 for x <= 0
+constexpr double TrajectorySqrt(double x)
+{
+	if(!(x > 0.0)) return 0.0;
+	//scale by powers of 4 into [0.25,1), exact, so a few Newton steps converge
+	double m = x, scale = 1.0;
+	while(m >= 1.0) { m *= 0.25; scale *= 2.0; }
+	while(m < 0.25) { m *= 4.0; scale *= 0.5; }
+	double r = (m + 1.0) / 2;
+	for(int i = 0; i < 6; i++) r = (r + m / r) / 2;
+	//one more step from the exact residual m - r*r (Dekker's product) settles the last bit
+	double split = 134217729.0 * r;
+	double hi = split - (split - r);
+	double lo = r - hi;
+	double square = r * r;
+	double error = ((hi * hi - square) + 2 * hi * lo) + lo * lo;
+	r += ((m - square) - error) / (2 * r);
+	return r * scale;
+}
+
+constexpr void AddTrajectorySegment(TrajectoryPlan &plan, double duration, double jerk, double accel)
+{
+	if(duration <= 0.0) return;
+	TrajectorySegment &seg = plan.Segments[plan.SegmentCount++];
+	seg.Duration = duration;
+	seg.Jerk = jerk;
+	seg.Accel = accel;
+	plan.Duration += duration;
+}
+
+//jerk limited change of speed from v0 to v1: time at max jerk, time at max accel, peak accel
+struct SCurveRamp
+{
+	double JerkTime = 0.0;
+	double AccelTime = 0.0;
+	double PeakAccel = 0.0;
+	double Distance = 0.0;
+};
+
+constexpr SCurveRamp PlanSCurveRamp(double v0, double v1, double accel, double jerk)
+{
+	SCurveRamp ramp;
+	double dv = TrajectoryAbs(v1 - v0);
+	if(dv >= accel * accel / jerk)
+	{
+		ramp.JerkTime = accel / jerk;
+		ramp.AccelTime = dv / accel - accel / jerk;
+		ramp.PeakAccel = accel;
+	}
+	else
+	{
+		ramp.JerkTime = TrajectorySqrt(dv / jerk);
+		ramp.PeakAccel = jerk * ramp.JerkTime;
+	}
+	//the ramp is symmetric so the average speed is the midpoint
+	ramp.Distance = (v0 + v1) / 2 * (2 * ramp.JerkTime + ramp.AccelTime);
+	return ramp;
+}
+
+constexpr void AddSCurveRamp(TrajectoryPlan &plan, const SCurveRamp &ramp, double jerk, double sign)
+{
+	AddTrajectorySegment(plan,ramp.JerkTime,sign * jerk,0.0);
+	AddTrajectorySegment(plan,ramp.AccelTime,0.0,sign * ramp.PeakAccel);
+	AddTrajectorySegment(plan,ramp.JerkTime,-sign * jerk,sign * ramp.PeakAccel);
+}
+
+constexpr TrajectoryPlan PlanSCurve(double distance, const MotionLimits &limits)
+{
+	TrajectoryPlan plan;
+	double accel = limits.MaxAccel;
+	double jerk = limits.MaxJerk;
+	double v0 = limits.StartVelocity;
+	double v1 = limits.EndVelocity;
+	double vPeak = limits.MaxVelocity;
+
+	plan.Distance = distance;
+	//too short to reach the end speed, settle for what can be reached (bisection)
+	double vLow = TrajectoryMax(v0,v1);
+	if(PlanSCurveRamp(v0,v1,accel,jerk).Distance > distance)
+	{
+		double lo = v0, hi = v1;
+		for(int i = 0; i < 60; i++)
+		{
+			double mid = (lo + hi) / 2;
+			if(PlanSCurveRamp(v0,mid,accel,jerk).Distance > distance) hi = mid;
+			else lo = mid;
+		}
+		v1 = lo;
+		vPeak = TrajectoryMax(v0,v1);
+	}
+	else if(PlanSCurveRamp(v0,vPeak,accel,jerk).Distance + PlanSCurveRamp(vPeak,v1,accel,jerk).Distance > distance)
+	{
+		//no room to cruise, find the highest peak that still fits
+		double lo = vLow, hi = vPeak;
+		for(int i = 0; i < 60; i++)
+		{
+			double mid = (lo + hi) / 2;
+			if(PlanSCurveRamp(v0,mid,accel,jerk).Distance + PlanSCurveRamp(mid,v1,accel,jerk).Distance > distance) hi = mid;
+			else lo = mid;
+		}
+		vPeak = lo;
+	}
+
+	SCurveRamp up = PlanSCurveRamp(v0,vPeak,accel,jerk);
+	SCurveRamp down = PlanSCurveRamp(vPeak,v1,accel,jerk);
+	double cruise = distance - up.Distance - down.Distance;
+
+	plan.StartVelocity = v0;
+	plan.EndVelocity = v1;
+	AddSCurveRamp(plan,up,jerk,1.0);
+	if(vPeak > 0) AddTrajectorySegment(plan,cruise / vPeak,0.0,0.0);
+	AddSCurveRamp(plan,down,jerk,-1.0);
+	return plan;
+}
+
+//plan a move of the given distance within the limits
+constexpr TrajectoryPlan PlanTrajectory(double distance, const MotionLimits &limits)
+{
+	TrajectoryPlan plan;
+	double accel = limits.MaxAccel;
+	double v0 = limits.StartVelocity;
+	double v1 = limits.EndVelocity;
+
+	plan.Distance = TrajectoryAbs(distance);
+	if(plan.Distance <= 0.0 || accel <= 0.0 || limits.MaxVelocity <= 0.0)
+	{
+		plan.StartVelocity = plan.EndVelocity = v0;
+		return plan;
+	}
+	if(limits.MaxJerk > 0.0) return PlanSCurve(plan.Distance,limits);
+
+	//peak speed where the accel and decel ramps meet, limited by max velocity
+	double vPeak = TrajectorySqrt((2 * accel * plan.Distance + v0 * v0 + v1 * v1) / 2);
+	if(vPeak > limits.MaxVelocity) vPeak = limits.MaxVelocity;
+	//too short to slow down to the end speed, or to speed up to it
+	if(vPeak < v0)
+	{
+		v1 = TrajectorySqrt(v0 * v0 - 2 * accel * plan.Distance);
+		vPeak = v0;
+	}
+	if(vPeak < v1)
+	{
+		v1 = TrajectorySqrt(v0 * v0 + 2 * accel * plan.Distance);
+		vPeak = v1;
+	}
+
+	double tAccel = (vPeak - v0) / accel;
+	double tDecel = (vPeak - v1) / accel;
+	double dRamps = (v0 + vPeak) / 2 * tAccel + (vPeak + v1) / 2 * tDecel;
+	double tCruise = vPeak > 0 ? (plan.Distance - dRamps) / vPeak : 0.0;
+
+	plan.StartVelocity = v0;
+	plan.EndVelocity = v1;
+	AddTrajectorySegment(plan,tAccel,0.0,accel);
+	AddTrajectorySegment(plan,tCruise,0.0,0.0);
+	AddTrajectorySegment(plan,tDecel,0.0,-accel);
+	return plan;
+}
+
+//samples a plan needs at dt, before SampleTrajectory limits it to the table
+constexpr int TrajectorySampleCount(const TrajectoryPlan &plan, double dt)
+{
+	double steps = plan.Duration / dt;
+	int count = int(steps);
+	if(count < steps) count++;
+	return count + 1;
+}
+
+//fill samples at dt (stretched if the table would overflow), returns number of samples and actual dt
+constexpr int SampleTrajectory(const TrajectoryPlan &plan, double dt, TrajectorySample *samples, int maxSamples, double *sampleDt)
+{
+	if(maxSamples < 2) return 0;
+	int count = TrajectorySampleCount(plan,dt);
+	if(count > maxSamples)
+	{
+		count = maxSamples;
+		dt = plan.Duration / (count - 1);
+	}
+	if(count < 2) count = 2;
+	*sampleDt = dt;
+
+	//integrate the segments exactly, visiting each sample time in order
+	double pos = 0.0, vel = plan.StartVelocity, acc = 0.0;
+	double segStart = 0.0;
+	int seg = 0;
+	for(int i = 0; i < count; i++)
+	{
+		double t = i * dt;
+		if(t > plan.Duration) t = plan.Duration;
+		while(seg < plan.SegmentCount && t > segStart + plan.Segments[seg].Duration)
+		{
+			const TrajectorySegment &s = plan.Segments[seg];
+			double tau = s.Duration;
+			pos += vel * tau + s.Accel * tau * tau / 2 + s.Jerk * tau * tau * tau / 6;
+			vel += s.Accel * tau + s.Jerk * tau * tau / 2;
+			segStart += tau;
+			seg++;
+		}
+		double p = pos, v = vel;
+		acc = 0.0;
+		if(seg < plan.SegmentCount)
+		{
+			const TrajectorySegment &s = plan.Segments[seg];
+			double tau = t - segStart;
+			p += vel * tau + s.Accel * tau * tau / 2 + s.Jerk * tau * tau * tau / 6;
+			v += s.Accel * tau + s.Jerk * tau * tau / 2;
+			acc = s.Accel + s.Jerk * tau;
+		}
+		samples[i].Time = t;
+		samples[i].Position = p;
+		samples[i].Velocity = v;
+		samples[i].Accel = acc;
+	}
+	//remove rounding so the table ends exactly on target
+	samples[count - 1].Position = plan.Distance;
+	samples[count - 1].Velocity = plan.EndVelocity;
+	samples[count - 1].Accel = 0.0;
+	return count;
+}
+
+//interpolated sample at time t, holds the last sample after the end of the table
+TrajectorySample LookupTrajectory(const TrajectorySample *samples, int count, double dt, double t);
+
+//a move tabled by the compiler, N from TrajectorySampleCount
+template<int N>
+struct TrajectoryTable
+{
+	TrajectorySample Samples[N];
+	int Count = 0;
+	double Dt = 0.0;
+	double Distance = 0.0;
+	MotionLimits Limits;		//what it was planned with, Profile::AddMove checks them
+};
+
+template<int N>
+constexpr TrajectoryTable<N> MakeTrajectoryTable(double distance, const MotionLimits &limits, double dt)
+{
+	TrajectoryTable<N> table;
+	TrajectoryPlan plan = PlanTrajectory(distance,limits);
+	table.Count = SampleTrajectory(plan,dt,table.Samples,N,&table.Dt);
+	table.Distance = plan.Distance;
+	table.Limits = limits;
+	return table;
+}
+
+//constexpr auto kMove = TRAJECTORY_TABLE(8.0,limits,0.01); sizes the table to the move
+#define TRAJECTORY_TABLE(distance,limits,dt) \
+	MakeTrajectoryTable<TrajectorySampleCount(PlanTrajectory(distance,limits),dt)>(distance,limits,dt)
+
+#endif /* SRC_TRAJECTORY_H_ */
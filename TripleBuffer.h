@@ -0,0 +1,49 @@
+/*
+ * TripleBuffer.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Latest value handoff between one writer thread and one reader thread.
+ *  The writer fills its own buffer and swaps it with the middle one, the
+ *  reader swaps the middle one with its own when something new is there.
+ *  Neither side ever waits for the other or sees a half written value, and
+ *  the reader always gets the newest complete value (older ones are dropped).
+ *
+ */
+
+#ifndef SRC_TRIPLEBUFFER_H_
+#define SRC_TRIPLEBUFFER_H_
+
+#include <atomic>
+#include <stdint.h>
+
+template <typename T> class TripleBuffer
+{
+private:
+	static const uint8_t kIndexMask = 3;
+	static const uint8_t kFresh = 4;		//set in Middle when the writer has swapped in a new value
+	T Buffers[3];
+	std::atomic<uint8_t> Middle;
+	uint8_t Back = 0;		//writer's buffer
+	uint8_t Front = 2;		//reader's buffer
+public:
+	TripleBuffer() : Buffers(), Middle(1) {}
+
+	//writer side, publish a copy of value
+	void Write(const T &value)
+	{
+		Buffers[Back] = value;
+		Back = Middle.exchange(Back | kFresh,std::memory_order_acq_rel) & kIndexMask;
+	}
+
+	//reader side, newest published value (a default T until the first Write)
+	//the reference stays valid until the next Read
+	const T &Read()
+	{
+		if(Middle.load(std::memory_order_relaxed) & kFresh)
+			Front = Middle.exchange(Front,std::memory_order_acq_rel) & kIndexMask;
+		return Buffers[Front];
+	}
+};
+
+#endif /* SRC_TRIPLEBUFFER_H_ */
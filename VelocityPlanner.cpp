@@ -0,0 +1,56 @@
+/*
+ * VelocityPlanner.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "VelocityPlanner.h"
+#include <math.h>
+
+double MaxPathVelocity(double curvature, const PathLimits &limits)
+{
+	double k = fabs(curvature);
+	double v = limits.MaxVelocity / (1 + k * limits.TrackWidth / 2);
+	if(k > 1e-6 && limits.MaxLateralAccel > 0)
+	{
+		double vCurve = sqrt(limits.MaxLateralAccel / k);
+		if(vCurve < v) v = vCurve;
+	}
+	return v;
+}
+
+double MaxPathAccel(double curvature, const PathLimits &limits)
+{
+	return limits.MaxAccel / (1 + fabs(curvature) * limits.TrackWidth / 2);
+}
+
+double MaxArcWheelVelocity(double ratio, const PathLimits &limits)
+{
+	//center speed is outer * (1 + ratio) / 2 and curvature 2 * (1 - ratio) / (TrackWidth * (1 + ratio)),
+	//so the centripetal acceleration is outer^2 * (1 - ratio^2) / (2 * TrackWidth)
+	double bend = 1 - ratio * ratio;
+	if(bend <= 1e-9 || limits.MaxLateralAccel <= 0) return limits.MaxVelocity;
+	return fmin(limits.MaxVelocity,sqrt(2 * limits.TrackWidth * limits.MaxLateralAccel / bend));
+}
+
+void PlanPathVelocity(const double *distance, const double *curvature, int count,
+		const PathLimits &limits, double startVelocity, double endVelocity, double *velocity)
+{
+	if(count <= 0) return;
+	for(int i = 0; i < count; i++) velocity[i] = MaxPathVelocity(curvature[i],limits);
+	velocity[0] = fmin(velocity[0],startVelocity);
+	velocity[count-1] = fmin(velocity[count-1],endVelocity);
+	//a step is held to the acceleration of its tighter end
+	for(int i = 1; i < count; i++)
+	{
+		double accel = MaxPathAccel(fmax(fabs(curvature[i-1]),fabs(curvature[i])),limits);
+		double v = sqrt(velocity[i-1] * velocity[i-1] + 2 * accel * (distance[i] - distance[i-1]));
+		if(v < velocity[i]) velocity[i] = v;
+	}
+	for(int i = count - 2; i >= 0; i--)
+	{
+		double accel = MaxPathAccel(fmax(fabs(curvature[i]),fabs(curvature[i+1])),limits);
+		double v = sqrt(velocity[i+1] * velocity[i+1] + 2 * accel * (distance[i+1] - distance[i]));
+		if(v < velocity[i]) velocity[i] = v;
+	}
+}
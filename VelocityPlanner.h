@@ -0,0 +1,44 @@
+/*
+ * VelocityPlanner.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Speed limits for a differential drive on a curved path.  On a path with
+ *  curvature k the outside wheel runs at v * (1 + |k| * TrackWidth / 2), so
+ *  the speed of the center is limited by:
+ *     the outside wheel staying at or under MaxVelocity (the side never
+ *     saturates, so the inside wheel keeps its ratio and the turn its radius)
+ *     the centripetal acceleration v^2 * |k| staying under MaxLateralAccel
+ *  and the acceleration along the path by the outside wheel staying under
+ *  MaxAccel.  PlanPathVelocity puts these together with a forward and a
+ *  backward pass, which gives the minimum time speed at every point.
+ *
+ *  Curvature is 1/feet, either sign.  The wheel acceleration from the
+ *  curvature changing along the path is left out, paths are smooth enough
+ *  at 0.05 ft spacing that it is small next to the speed change.
+ *
+ */
+
+#ifndef SRC_VELOCITYPLANNER_H_
+#define SRC_VELOCITYPLANNER_H_
+
+struct PathLimits
+{
+	double MaxVelocity = 0.0;		//ft/s of the faster wheel
+	double MaxAccel = 0.0;			//ft/s^2 of the faster wheel
+	double MaxLateralAccel = 0.0;	//ft/s^2 across the path, 0 for no limit
+	double TrackWidth = 0.0;		//feet between left and right wheels
+};
+
+//fastest speed of the center on a curvature
+double MaxPathVelocity(double curvature, const PathLimits &limits);
+//fastest acceleration of the center on a curvature
+double MaxPathAccel(double curvature, const PathLimits &limits);
+//fastest outside wheel speed on an arc with the inside wheel at ratio of it (-1 to 1, 1 is straight)
+double MaxArcWheelVelocity(double ratio, const PathLimits &limits);
+//fill velocity with the fastest speed of the center at each of count points, at distance[i]
+//along the path with curvature[i], starting at startVelocity and ending at endVelocity
+void PlanPathVelocity(const double *distance, const double *curvature, int count,
+		const PathLimits &limits, double startVelocity, double endVelocity, double *velocity);
+
+#endif /* SRC_VELOCITYPLANNER_H_ */
@@ -0,0 +1,419 @@
+/*
+ * AutoTune.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Searches the Profile gains offline against SimRobotIO.  TURN and MOVE are
+ *  tuned separately with Nelder-Mead, each candidate is scored by running a set
+ *  of turns or moves on a nominal robot and on randomly disturbed robots, spread
+ *  over all cores.  The score is the time to finish the step plus a penalty for
+ *  overshoot and for where the robot ends up once it has coasted to a stop.
+ *  The tuned gains are checked on robots that were not used for the search and
+ *  written in the format Profile::LoadGains reads at RobotInit:
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/AutoTune.cpp -o autotune -pthread
+ *     ./autotune [gains file] [robots] [threads]
+ *     scp gains.txt lvuser@roborio-6055-frc.local:/home/lvuser/gains.txt
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "Robot.h"
+#include "Profile.h"
+#include "SimRobotIO.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdlib.h>
+#include <vector>
+
+static const double kTurnSpeed = 0.5;		//Robot::TurnMaxSpeed
+static const double kTurnTimeout = 5.0;		//seconds before a step counts as failed
+static const double kMoveTimeout = 10.0;
+static const double kFailPenalty = 5.0;
+static const double kCoastTime = 0.5;		//seconds with the drive off after the step
+static const double kTick = 1.0 / DriveLoop::kDefaultRate;	//the profile runs in the drive loop
+static const double kOvershootCost = 0.02;	//seconds per degree past the target
+static const double kHeadingCost = 0.05;	//seconds per degree off the target at rest
+static const double kDistanceCost = 0.5;	//seconds per foot off the target at rest
+
+//one step to run from a standing start at heading 0
+struct Scenario
+{
+	ProfileCommand Command;
+	double Target;		//heading for TURN, feet for MOVE
+	double Speed;		//TURN speed, negative turns left; MOVE direction, negative is reverse
+};
+
+static const Scenario TurnScenarios[] =
+{
+	{kProfileTurn,90,kTurnSpeed},
+	{kProfileTurn,270,-kTurnSpeed},
+	{kProfileTurn,35,kTurnSpeed},
+	{kProfileTurn,315,-kTurnSpeed},
+};
+
+static const Scenario MoveScenarios[] =
+{
+	{kProfileMove,4,1},
+	{kProfileMove,13,1},
+	{kProfileMove,20,1},
+	{kProfileMove,8,-1},
+};
+
+//a gain the search moves, starting from the Profile value with the given simplex step
+//Auto_Drive turns on the log of Curve so the steering gain is searched in decades
+struct TuneParam
+{
+	const char *Name;
+	double Profile::*Gain;
+	double Step;
+	bool LogScale;
+};
+
+static const TuneParam TurnParams[] =
+{
+	{"ProfileTurnKp",&Profile::ProfileTurnKp,0.02,false},
+	{"ProfileTurnKd",&Profile::ProfileTurnKd,0.001,false},
+};
+
+static const TuneParam MoveParams[] =
+{
+	{"ProfileSteerKp",&Profile::ProfileSteerKp,0.5,true},
+	{"ProfileSteerKd",&Profile::ProfileSteerKd,0.0005,false},
+	{"ProfileMoveKp",&Profile::ProfileMoveKp,0.1,false},
+};
+
+//search coordinate to gain and back, gains are magnitudes so they stay at or above 0
+static double ToGain(const TuneParam &param, double x)
+{
+	return param.LogScale ? pow(10.0,x) : std::max(0.0,x);
+}
+
+static double FromGain(const TuneParam &param, double gain)
+{
+	return param.LogScale ? log10(fabs(gain)) : fabs(gain);
+}
+
+struct TrialResult
+{
+	double Time;		//seconds to finish the step
+	double Overshoot;	//degrees past the target heading (TURN) or feet past the target distance (MOVE)
+	double Error;		//degrees (TURN) or feet (MOVE) from the target at rest
+	double Cost;
+};
+
+//one robot and profile per worker, reused for every trial the worker runs
+struct Worker
+{
+	SimRobotIO IO;
+	Robot Bot;
+	std::unique_ptr<Profile> Tuned;
+	bool Ready = false;
+};
+
+typedef std::vector<double> Point;
+
+struct Search
+{
+	const char *Name;
+	const Scenario *Scenarios;
+	int ScenarioCount;
+	const TuneParam *Params;
+	int ParamCount;
+};
+
+class Tuner
+{
+private:
+	ThreadPool &Pool;
+	std::vector<std::unique_ptr<Worker>> Workers;
+	const Profile &Base;
+	std::vector<SimParams> Robots;
+public:
+	int Evaluations = 0;
+
+	Tuner(ThreadPool &pool, const Profile &base) : Pool(pool), Base(base)
+	{
+		for(int i = 0; i < pool.GetThreadCount(); i++) Workers.emplace_back(new Worker());
+	}
+
+	//the first robot is the ideal one, the rest are disturbed
+	void SetRobots(int count, uint32_t seed)
+	{
+		Robots.assign(1,SimParams());
+		for(int i = 1; i < count; i++) Robots.push_back(PerturbSimParams(seed + i));
+	}
+
+	TrialResult RunTrial(Worker &worker, const Search &search, const Point &point,
+			const Scenario &scenario, const SimParams &params)
+	{
+		if(!worker.Ready)
+		{
+			//on the worker's own thread so the logger and clock are per thread
+			worker.Bot.ControlInit(&worker.IO);
+			worker.Tuned.reset(new Profile(&worker.IO));
+			worker.Ready = true;
+		}
+		Profile &profile = *worker.Tuned;
+		for(const auto &entry : TurnParams) profile.*entry.Gain = Base.*entry.Gain;
+		for(const auto &entry : MoveParams) profile.*entry.Gain = Base.*entry.Gain;
+		for(int i = 0; i < search.ParamCount; i++) profile.*search.Params[i].Gain = ToGain(search.Params[i],point[i]);
+		//same speeds as Robot::AutonomousInit
+		profile.ProfileMinSpeed = 0.35;
+		profile.ProfileMaxSpeed = 0.75;
+		profile.ProfileContinuous = false;
+		profile.Initialize();
+		profile.ClearProfile();
+		if(scenario.Command == kProfileTurn)
+			profile.AddTurn(scenario.Target,scenario.Speed);
+		else
+			profile.AddMove(scenario.Speed < 0 ? Profile::kProfileReverse : Profile::kProfileForward,scenario.Target);
+
+		worker.IO.Reset(params);
+		//the robot's getters read the sensor snapshot, sample it like each periodic does
+		worker.Bot.ReadSensors();
+		worker.Bot.ZeroHeading();
+		double timeout = scenario.Command == kProfileTurn ? kTurnTimeout : kMoveTimeout;
+		double feetPerPulse = params.FeetPerPulse;
+		TrialResult result = {0.0,0.0,0.0,0.0};
+		double error = 0.0;
+		double coast = 0.0;
+		for(double t = 0.0; coast < kCoastTime; t += kTick)
+		{
+			worker.Bot.ReadSensors();
+			if(!profile.ProfileCompleted && t < timeout)
+			{
+				profile.ExecuteProfile(worker.Bot.GetHeading(),fabs(worker.Bot.GetDistance()));
+				worker.Bot.Auto_Drive(profile.OutputMagnitude,profile.Curve);
+				result.Time = t;
+			}
+			else
+			{
+				worker.Bot.Auto_Drive(0.0,0.0);
+				coast += kTick;
+			}
+			worker.IO.Step(kTick);
+
+			//score from the sim's true pose, positive is past the target
+			double past;
+			if(scenario.Command == kProfileTurn)
+			{
+				error = remainder(worker.IO.GetHeading() - scenario.Target,360.0);
+				past = scenario.Speed < 0 ? -error : error;
+			}
+			else
+			{
+				double travel = (worker.IO.GetLeftEncoder() * Robot::kLeftEncoderSign +
+						worker.IO.GetRightEncoder() * Robot::kRightEncoderSign) / 2.0 * feetPerPulse;
+				error = fabs(travel) - scenario.Target;
+				past = error;
+			}
+			result.Overshoot = std::max(result.Overshoot,past);
+		}
+		result.Error = fabs(error);
+		result.Cost = result.Time;
+		if(!profile.ProfileCompleted) result.Cost += kFailPenalty;
+		if(scenario.Command == kProfileTurn)
+			result.Cost += kOvershootCost * result.Overshoot + kHeadingCost * result.Error;
+		else
+			result.Cost += kDistanceCost * (result.Error + fabs(worker.IO.GetY()))
+					+ kHeadingCost * fabs(remainder(worker.IO.GetHeading(),360.0));
+		return result;
+	}
+
+	//every scenario on every robot for each point, all in parallel
+	std::vector<TrialResult> RunAll(const Search &search, const std::vector<Point> &points)
+	{
+		size_t trials = size_t(search.ScenarioCount) * Robots.size();
+		std::vector<TrialResult> results(points.size() * trials);
+		for(size_t p = 0; p < points.size(); p++)
+		{
+			for(size_t t = 0; t < trials; t++)
+			{
+				Pool.Submit([&,p,t](int w)
+				{
+					results[p * trials + t] = RunTrial(*Workers[w],search,points[p],
+							search.Scenarios[t / Robots.size()],Robots[t % Robots.size()]);
+				});
+			}
+		}
+		Pool.Wait();
+		Evaluations += points.size();
+		return results;
+	}
+
+	//mean cost of each point
+	std::vector<double> Evaluate(const Search &search, const std::vector<Point> &points)
+	{
+		std::vector<TrialResult> results = RunAll(search,points);
+		size_t trials = results.size() / points.size();
+		std::vector<double> costs(points.size(),0.0);
+		for(size_t i = 0; i < results.size(); i++) costs[i / trials] += results[i].Cost / trials;
+		return costs;
+	}
+
+	double Evaluate(const Search &search, const Point &point)
+	{
+		return Evaluate(search,std::vector<Point>(1,point))[0];
+	}
+};
+
+static Point Blend(const Point &a, const Point &b, double k)
+{
+	//a + k * (b - a)
+	Point p(a.size());
+	for(size_t i = 0; i < a.size(); i++) p[i] = a[i] + k * (b[i] - a[i]);
+	return p;
+}
+
+//Nelder-Mead with the reflection and expansion scored together so the pool has more work
+static Point NelderMead(Tuner &tuner, const Search &search, const Point &start, int maxIterations)
+{
+	int n = search.ParamCount;
+	std::vector<Point> simplex(1,start);
+	for(int i = 0; i < n; i++)
+	{
+		simplex.push_back(start);
+		simplex.back()[i] += search.Params[i].Step;
+	}
+	std::vector<double> cost = tuner.Evaluate(search,simplex);
+
+	for(int iter = 0; iter < maxIterations; iter++)
+	{
+		std::vector<int> order(n + 1);
+		for(int i = 0; i <= n; i++) order[i] = i;
+		std::sort(order.begin(),order.end(),[&](int a, int b) { return cost[a] < cost[b]; });
+		int best = order[0], second = order[n - 1], worst = order[n];
+
+		printf("%-5s %3i  cost %7.4f ",search.Name,iter,cost[best]);
+		for(int i = 0; i < n; i++) printf(" %s=%.4g",search.Params[i].Name,ToGain(search.Params[i],simplex[best][i]));
+		printf("\n");
+		if(cost[worst] - cost[best] < 1e-4) break;
+
+		Point centroid(n,0.0);
+		for(int v = 0; v <= n; v++)
+		{
+			if(v == worst) continue;
+			for(int i = 0; i < n; i++) centroid[i] += simplex[v][i] / n;
+		}
+		std::vector<Point> tries = {Blend(centroid,simplex[worst],-1.0),Blend(centroid,simplex[worst],-2.0)};
+		std::vector<double> tryCost = tuner.Evaluate(search,tries);
+		if(tryCost[0] < cost[best])
+		{
+			int pick = tryCost[1] < tryCost[0] ? 1 : 0;
+			simplex[worst] = tries[pick];
+			cost[worst] = tryCost[pick];
+			continue;
+		}
+		if(tryCost[0] < cost[second])
+		{
+			simplex[worst] = tries[0];
+			cost[worst] = tryCost[0];
+			continue;
+		}
+		//contract toward the better of the reflection and the worst point
+		bool outside = tryCost[0] < cost[worst];
+		Point contracted = Blend(centroid,outside ? tries[0] : simplex[worst],0.5);
+		double contractedCost = tuner.Evaluate(search,contracted);
+		if(contractedCost < std::min(tryCost[0],cost[worst]))
+		{
+			simplex[worst] = contracted;
+			cost[worst] = contractedCost;
+			continue;
+		}
+		//shrink everything toward the best point
+		std::vector<Point> shrunk;
+		for(int v = 0; v <= n; v++)
+			if(v != best) shrunk.push_back(Blend(simplex[best],simplex[v],0.5));
+		std::vector<double> shrunkCost = tuner.Evaluate(search,shrunk);
+		for(int v = 0, s = 0; v <= n; v++)
+		{
+			if(v == best) continue;
+			simplex[v] = shrunk[s];
+			cost[v] = shrunkCost[s++];
+		}
+	}
+	int best = std::min_element(cost.begin(),cost.end()) - cost.begin();
+	return simplex[best];
+}
+
+static void Report(Tuner &tuner, const Search &search, const Point &before, const Point &after)
+{
+	std::vector<TrialResult> results = tuner.RunAll(search,{before,after});
+	size_t trials = results.size() / 2;
+	size_t robots = trials / search.ScenarioCount;
+	const char *units = search.Scenarios[0].Command == kProfileTurn ? "deg" : "ft";
+	printf("%-5s %6s %6s   %-22s overshoot %-12s at rest %-14s\n","","target","speed",
+			"time s (default/tuned)",units,units);
+	for(int s = 0; s < search.ScenarioCount; s++)
+	{
+		double mean[2][3] = {};
+		for(int p = 0; p < 2; p++)
+		{
+			for(size_t r = 0; r < robots; r++)
+			{
+				const TrialResult &result = results[p * trials + s * robots + r];
+				mean[p][0] += result.Time / robots;
+				mean[p][1] += result.Overshoot / robots;
+				mean[p][2] += result.Error / robots;
+			}
+		}
+		printf("%-5s %6.0f %6.2f   %9.2f %-12.2f %9.2f %-12.2f %9.2f %-12.2f\n",search.Name,
+				search.Scenarios[s].Target,search.Scenarios[s].Speed,mean[0][0],mean[1][0],
+				mean[0][1],mean[1][1],mean[0][2],mean[1][2]);
+	}
+	printf("%-5s mean cost %.4f -> %.4f\n\n",search.Name,tuner.Evaluate(search,before),
+			tuner.Evaluate(search,after));
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "gains.txt";
+	int robots = argc > 2 ? atoi(argv[2]) : 12;
+	int threads = argc > 3 ? atoi(argv[3]) : 0;
+	if(robots < 1) robots = 1;
+
+	ThreadPool pool(threads);
+	SimRobotIO clock;
+	Profile tuned(&clock);
+	Profile defaults(&clock);
+	Tuner tuner(pool,defaults);
+	const Search searches[] =
+	{
+		{"TURN",TurnScenarios,4,TurnParams,2},
+		{"MOVE",MoveScenarios,4,MoveParams,3},
+	};
+
+	auto begin = std::chrono::steady_clock::now();
+	std::vector<Point> start, found;
+	for(const Search &search : searches)
+	{
+		Point point;
+		for(int i = 0; i < search.ParamCount; i++) point.push_back(FromGain(search.Params[i],defaults.*search.Params[i].Gain));
+		tuner.SetRobots(robots,1000);
+		Point best = NelderMead(tuner,search,point,60);
+		for(int i = 0; i < search.ParamCount; i++) tuned.*search.Params[i].Gain = ToGain(search.Params[i],best[i]);
+		start.push_back(point);
+		found.push_back(best);
+	}
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	//check on robots the search never saw
+	printf("\n");
+	tuner.SetRobots(robots,50000);
+	for(int s = 0; s < 2; s++) Report(tuner,searches[s],start[s],found[s]);
+
+	if(tuned.SaveGains(path) < 0)
+	{
+		printf("could not write %s\n",path);
+		return 1;
+	}
+	printf("%i candidates on %i robots, %i threads in %.2f s, gains written to %s\n",tuner.Evaluations,
+			robots,pool.GetThreadCount(),secs,path);
+	return 0;
+}
+
+#endif
@@ -0,0 +1,390 @@
+/*
+ * Bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Microbenchmarks for the code that runs every 20ms control cycle.
+ *  Reports ns/call (mean, stddev, min over repetitions) and heap allocations
+ *  per call so changes to the per-cycle budget show up on a dev box.
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/Bench.cpp -o bench -pthread
+ *     ./bench [filter]
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "Robot.h"
+#include "Profile.h"
+#include "PID.h"
+#include "Odometry.h"
+#include "Logger.h"
+#include "LoopTiming.h"
+#include "SimRobotIO.h"
+#include <chrono>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+//count every heap allocation made while a benchmark runs
+static uint64_t AllocCount = 0;
+
+void *operator new(size_t size)
+{
+	AllocCount++;
+	void *p = malloc(size ? size : 1);
+	if(!p) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+//keep the compiler from optimizing away a result
+template <typename T> inline void DoNotOptimize(const T &value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//manual clock so PAUSE and trajectory steps see time move without a real FPGA
+class BenchClock : public Clock
+{
+public:
+	uint64_t Now = 0;
+	uint64_t GetFPGATime() { return Now += 20000; }
+};
+
+//benchmarks bracket their timed loop with StartTimer/StopTimer so setup is not measured
+struct BenchState
+{
+	uint64_t Iterations;
+	double Nanoseconds;
+	uint64_t Allocs;
+	std::chrono::steady_clock::time_point Start;
+
+	void StartTimer()
+	{
+		Allocs = AllocCount;
+		Start = std::chrono::steady_clock::now();
+	}
+	void StopTimer()
+	{
+		auto end = std::chrono::steady_clock::now();
+		Allocs = AllocCount - Allocs;
+		Nanoseconds = std::chrono::duration<double, std::nano>(end - Start).count();
+	}
+};
+
+typedef void (*BenchFunc)(BenchState &state);
+
+struct BenchEntry
+{
+	const char *Name;
+	BenchFunc Func;
+};
+
+static const int kRepetitions = 10;
+static const uint64_t kIterations = 200000;
+
+static void RunBench(const BenchEntry &bench)
+{
+	double nsPerCall[kRepetitions];
+	uint64_t allocs = 0;
+	BenchState state;
+
+	//warm up once so cold caches are not measured
+	state.Iterations = 1000;
+	bench.Func(state);
+
+	state.Iterations = kIterations;
+	for(int rep = 0; rep < kRepetitions; rep++)
+	{
+		bench.Func(state);
+		allocs += state.Allocs;
+		nsPerCall[rep] = state.Nanoseconds / kIterations;
+	}
+
+	double mean = 0.0, min = nsPerCall[0];
+	for(int rep = 0; rep < kRepetitions; rep++)
+	{
+		mean += nsPerCall[rep];
+		if(nsPerCall[rep] < min) min = nsPerCall[rep];
+	}
+	mean /= kRepetitions;
+	double var = 0.0;
+	for(int rep = 0; rep < kRepetitions; rep++) var += (nsPerCall[rep] - mean) * (nsPerCall[rep] - mean);
+	var /= kRepetitions - 1;
+
+	fprintf(stderr,"%-32s %10.1f %10.2f %10.1f %12.4f\n",bench.Name,mean,sqrt(var),min,
+			double(allocs) / (double(kIterations) * kRepetitions));
+}
+
+//********* BENCHMARKS **********
+//Each one runs state.Iterations calls.  Steps are made long enough that the loop
+//never finishes them, and the first call (which prints the step start) is untimed.
+
+static void BM_ExecuteProfile_Move(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	profile.AddMove(Profile::kProfileForward,1000);
+	profile.ExecuteProfile(1.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		profile.ExecuteProfile(1.0,(i % 4000) * 0.1);
+		DoNotOptimize(profile.OutputMagnitude);
+	}
+	state.StopTimer();
+}
+
+static void BM_ExecuteProfile_Turn(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	profile.AddTurn(90,0.5);
+	profile.ExecuteProfile(0.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		profile.ExecuteProfile((i % 80) * 1.0,0.0);
+		DoNotOptimize(profile.OutputMagnitude);
+	}
+	state.StopTimer();
+}
+
+static void BM_ExecuteProfile_Pause(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	profile.AddPause(1e15);
+	profile.ExecuteProfile(0.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		profile.ExecuteProfile(0.0,0.0);
+		DoNotOptimize(profile.OutputMagnitude);
+	}
+	state.StopTimer();
+}
+
+static void BM_ExecuteProfile_Curve(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	profile.AddCurve(Profile::kProfileForward,1000,0.2);
+	profile.ExecuteProfile(1.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		profile.ExecuteProfile(1.0,(i % 4000) * 0.1);
+		DoNotOptimize(profile.OutputMagnitude);
+	}
+	state.StopTimer();
+}
+
+static void BM_ExecuteProfile_Spline(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	const Waypoint path[] = {{0,0,0},{40,0,0},{60,20,90}};
+	profile.AddSpline(path,3);
+	profile.ExecuteProfile(0.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		profile.ExecuteProfile((i % 90) * 1.0,(i % 400) * 0.1);
+		DoNotOptimize(profile.OutputMagnitude);
+	}
+	state.StopTimer();
+}
+
+static void BM_ExecuteProfile_SplineFollower(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	profile.ProfileFollower = true;
+	const Waypoint path[] = {{0,0,0},{40,0,0},{60,20,90}};
+	profile.AddSpline(path,3);
+	profile.ExecuteProfile(0.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		//the follower finishes on time, so keep the clock inside the path
+		clock.Now = 1000000 + (i % 100) * 20000;
+		profile.ExecuteProfile((i % 90) * 1.0,(i % 400) * 0.1);
+		DoNotOptimize(profile.OutputMagnitude);
+	}
+	state.StopTimer();
+}
+
+//what AutonomousPeriodic state 0 does on the first cycle of the match
+static void BM_BuildProfile(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		profile.Initialize();
+		profile.ClearProfile();
+		profile.AddMove(Profile::kProfileForward,13 + (i % 8));
+		profile.AddTurn(90,0.5);
+		profile.AddMove(Profile::kProfileForward,2);
+		DoNotOptimize(profile.ProfileStep);
+	}
+	state.StopTimer();
+}
+
+static void BM_Get_Trajectory(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	profile.AddMove(Profile::kProfileForward,1000);
+	profile.ExecuteProfile(1.0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+		DoNotOptimize(profile.Get_Trajectory((i % 10000) * 0.1));
+	state.StopTimer();
+}
+
+static void BM_PID_Update(BenchState &state)
+{
+	PID pid(0.05,0.05,0.0005);
+	pid.SetOutputRange(-1.0,1.0);
+	pid.SetDerivativeFilter(0.05);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+		DoNotOptimize(pid.Update(0.0,(i % 100) * 0.5,i * 20000));
+	state.StopTimer();
+}
+
+struct BenchGains
+{
+	static constexpr double kP = 0.05;
+	static constexpr double kI = 0.05;
+	static constexpr double kD = 0.0005;
+};
+
+static void BM_PID_UpdateFixed(BenchState &state)
+{
+	PIDController<FixedGains<BenchGains>> pid;
+	pid.SetOutputRange(-1.0,1.0);
+	pid.SetDerivativeFilter(0.05);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+		DoNotOptimize(pid.Update(0.0,(i % 100) * 0.5,i * 20000));
+	state.StopTimer();
+}
+
+static void BM_Auto_Drive(BenchState &state)
+{
+	static SimRobotIO io;
+	static Robot robot;
+	static bool init = false;
+	if(!init)
+	{
+		robot.ControlInit(&io);
+		init = true;
+	}
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+		robot.Auto_Drive(-0.75,(int(i % 21) - 10) * 0.05);
+	state.StopTimer();
+}
+
+static void BM_Odometry_Update(BenchState &state)
+{
+	Odometry odometry(0.0008538755);
+	odometry.Reset(Pose2d(),0,0,0.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		odometry.Update(int(i * 300),int(i * 280),(i % 360) * 1.0);
+		DoNotOptimize(odometry.GetPose());
+	}
+	state.StopTimer();
+}
+
+//a control loop write and the flusher's read of one record, without the printf
+static void BM_LogRing_PushPop(BenchState &state)
+{
+	static LogRing ring;
+	LogRecord record = {};
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		record.Value[0] = i;
+		ring.Push(record);
+		ring.Pop(&record);
+		DoNotOptimize(record);
+	}
+	state.StopTimer();
+}
+
+//the probe around every periodic body, budget never exceeded so nothing is logged
+static void BM_LoopTiming(BenchState &state)
+{
+	BenchClock clock;
+	static LoopTiming timing(&clock,1.0);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+	{
+		timing.BeginCycle();
+		timing.EndCycle();
+	}
+	state.StopTimer();
+	DoNotOptimize(timing.GetOverruns());
+}
+
+static void BM_GetNormalizedError(BenchState &state)
+{
+	BenchClock clock;
+	Profile profile(&clock);
+	state.StartTimer();
+	for(uint64_t i = 0; i < state.Iterations; i++)
+		DoNotOptimize(profile.GetNormalizedError((i % 360) * 1.0,90.0));
+	state.StopTimer();
+}
+
+static const BenchEntry Benchmarks[] =
+{
+	{"ExecuteProfile/MOVE",BM_ExecuteProfile_Move},
+	{"ExecuteProfile/TURN",BM_ExecuteProfile_Turn},
+	{"ExecuteProfile/PAUSE",BM_ExecuteProfile_Pause},
+	{"ExecuteProfile/CURVE",BM_ExecuteProfile_Curve},
+	{"ExecuteProfile/SPLINE",BM_ExecuteProfile_Spline},
+	{"ExecuteProfile/SPLINE+Ramsete",BM_ExecuteProfile_SplineFollower},
+	{"Profile build MOVE/TURN/MOVE",BM_BuildProfile},
+	{"Profile::Get_Trajectory",BM_Get_Trajectory},
+	{"PID::Update",BM_PID_Update},
+	{"PID::Update fixed gains",BM_PID_UpdateFixed},
+	{"Robot::Auto_Drive",BM_Auto_Drive},
+	{"Odometry::Update",BM_Odometry_Update},
+	{"LogRing push+pop",BM_LogRing_PushPop},
+	{"LoopTiming begin+end",BM_LoopTiming},
+	{"Profile::GetNormalizedError",BM_GetNormalizedError},
+};
+
+int main(int argc, char **argv)
+{
+	const char *filter = argc > 1 ? argv[1] : "";
+	//setup printfs from the profile go to stdout, results go to stderr
+	fprintf(stderr,"%-32s %10s %10s %10s %12s\n","Benchmark","ns/call","stddev","min","allocs/call");
+	for(const BenchEntry &bench : Benchmarks)
+	{
+		if(strstr(bench.Name,filter) == NULL) continue;
+		fflush(stdout);
+		RunBench(bench);
+	}
+	return 0;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * CanPlan.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Runs the CanScheduler against mock Talons laid out like the robot's drive
+ *  (LF and RF masters, LR and RR followers) and prints the status frame
+ *  periods it picks, the bus load against the Phoenix defaults and the room
+ *  left for more devices.  Build and run from the src folder:
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/CanPlan.cpp -o canplan -pthread
+ *     ./canplan [drive loop hz] [-m]        -m plans for motion profile streaming
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "CanScheduler.h"
+#include "DriveLoop.h"
+#include "Logger.h"
+#include "SimRobotIO.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *kFrameNames[kCanStatusCount] =
+{
+	"General","Feedback","Quad","AinTempVbat","PulseWidth","MPBuffer","Targets","PIDF0","PIDF1"
+};
+
+int main(int argc, char **argv)
+{
+	double rate = DriveLoop::kDefaultRate;
+	bool streaming = false;
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i],"-m") == 0) streaming = true;
+		else rate = atof(argv[i]);
+	}
+	SimRobotIO io;
+	Logger::Init(&io);
+	Logger::AttachThread();
+
+	//CAN IDs from Robot::RobotInit
+	SimCanDevice motorLF(4), motorRF(1), motorLR(3), motorRR(2);
+	const char *names[] = {"LF","RF","LR","RR"};
+	CanScheduler can(rate,streaming);
+	can.AddDevice(&motorLF,kCanDriveMaster);
+	can.AddDevice(&motorRF,kCanDriveMaster);
+	can.AddDevice(&motorLR,kCanDriveFollower);
+	can.AddDevice(&motorRR,kCanDriveFollower);
+	int refused = can.Configure();
+
+	printf("drive loop %.0f Hz%s\n%-8s",rate,streaming ? ", streaming" : "","");
+	for(int f = 0; f < kCanStatusCount; f++) printf("%12s",kFrameNames[f]);
+	printf("\n");
+	for(int d = 0; d < can.GetDeviceCount(); d++)
+	{
+		SimCanDevice *device = static_cast<SimCanDevice *>(can.GetDevice(d));
+		printf("%-2s (%2i)",names[d],device->GetDeviceID());
+		for(int f = 0; f < kCanStatusCount; f++)
+			printf("%9i ms",device->GetStatusFramePeriod(CanStatusFrame(f)));
+		printf("\n");
+	}
+	can.Report();
+	Logger::Flush();
+	return refused == 0 ? 0 : 1;
+}
+
+#endif
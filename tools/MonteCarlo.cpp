@@ -0,0 +1,174 @@
+/*
+ * MonteCarlo.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Runs every autonomous routine against every game data layout many times
+ *  with a randomly disturbed SimRobotIO (wheel slip, gyro drift, motor
+ *  response and strength, battery sag) on all cores, then reports the spread
+ *  of completion time and of the end pose error against an undisturbed run.
+ *  Trials are seeded by their index so a sweep is repeatable.
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/MonteCarlo.cpp -o montecarlo -pthread
+ *     ./montecarlo [trials per case] [threads] [-p] [-t]
+ *
+ *  -p drives the side switch deliveries as splines (Robot::AutoUseSplines),
+ *  -t also tracks them with the Ramsete follower (Profile::ProfileFollower).
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "Robot.h"
+#include "SimRobotIO.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static const int kRoutines = 6;		//thumbwheel 1-6
+static const char *Layouts[] = {"LLL","LRL","RLR","RRR"};
+static const int kLayouts = 4;
+static const int kCycles = 750;		//15 second autonomous at 20ms
+
+//plan options, set before the sweep starts
+static bool UseSplines = false;
+static bool UseFollower = false;
+
+struct TrialResult
+{
+	double CompleteTime;	//seconds, -1 if the routine never finished
+	double X;
+	double Y;
+	double Heading;
+};
+
+//one robot per worker, reused for every trial the worker runs
+struct Worker
+{
+	SimRobotIO IO;
+	Robot Bot;
+	bool Ready = false;
+};
+
+//one 20ms cycle of physics in 5ms steps (or finer), with the drive loop ticks spread through it
+static void StepCycle(Robot &robot, SimRobotIO &io)
+{
+	int ticks = robot.GetDriveLoopTicks();
+	int steps = ticks > 4 ? ticks : 4;
+	for(int i = 0; i < steps; i++)
+	{
+		if(ticks > 0 && (i * ticks) % steps < ticks) robot.DriveLoopTick();
+		io.Step(0.02 / steps);
+	}
+}
+
+static TrialResult RunTrial(Worker &worker, int routine, const char *layout, const SimParams &params)
+{
+	if(!worker.Ready)
+	{
+		//on the worker's own thread so the logger and clock are per thread
+		worker.Bot.ControlInit(&worker.IO,DriveLoop::kDefaultRate);
+		if(UseSplines) worker.Bot.SetAutoUseSplines(true);
+		if(UseFollower) worker.Bot.SetAutoFollower(true);
+		worker.Ready = true;
+	}
+	worker.IO.Reset(params);
+	worker.IO.SetThumbWheel(routine);
+	worker.IO.SetGameData(layout);
+	worker.Bot.AutonomousInit();
+
+	TrialResult result;
+	result.CompleteTime = -1.0;
+	for(int cycle = 0; cycle < kCycles; cycle++)
+	{
+		worker.Bot.AutonomousPeriodic();
+		if(result.CompleteTime < 0 && worker.Bot.IsAutoComplete())
+			result.CompleteTime = worker.IO.GetFPGATime() / 1000000.0;
+		StepCycle(worker.Bot,worker.IO);
+	}
+	result.X = worker.IO.GetX();
+	result.Y = worker.IO.GetY();
+	result.Heading = worker.IO.GetHeading();
+	return result;
+}
+
+static double Percentile(std::vector<double> &values, double pct)
+{
+	if(values.empty()) return 0.0;
+	size_t ndx = std::min(values.size() - 1,size_t(pct / 100.0 * values.size()));
+	std::nth_element(values.begin(),values.begin() + ndx,values.end());
+	return values[ndx];
+}
+
+int main(int argc, char **argv)
+{
+	int trials = 1000;
+	int threads = 0;
+	int positional = 0;
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i],"-p") == 0) UseSplines = true;
+		else if(strcmp(argv[i],"-t") == 0) UseFollower = true;
+		else if(positional++ == 0) trials = atoi(argv[i]);
+		else threads = atoi(argv[i]);
+	}
+	if(trials < 1) trials = 1;
+
+	ThreadPool pool(threads);
+	std::vector<std::unique_ptr<Worker>> workers;
+	for(int i = 0; i < pool.GetThreadCount(); i++) workers.emplace_back(new Worker());
+
+	//undisturbed run of each case is the reference for the pose error
+	const int cases = kRoutines * kLayouts;
+	std::vector<TrialResult> nominal(cases);
+	std::vector<TrialResult> results(size_t(cases) * trials);
+	auto begin = std::chrono::steady_clock::now();
+	for(int c = 0; c < cases; c++)
+	{
+		pool.Submit([&,c](int w)
+		{
+			nominal[c] = RunTrial(*workers[w],c / kLayouts + 1,Layouts[c % kLayouts],SimParams());
+		});
+		for(int t = 0; t < trials; t++)
+		{
+			pool.Submit([&,c,t](int w)
+			{
+				SimParams params = PerturbSimParams(uint32_t(c) * 1000003u + uint32_t(t));
+				results[size_t(c) * trials + t] = RunTrial(*workers[w],c / kLayouts + 1,Layouts[c % kLayouts],params);
+			});
+		}
+	}
+	pool.Wait();
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	printf("%-8s %-4s %7s %7s %7s %7s %6s  %7s %7s %7s  %7s %7s\n","routine","data",
+			"t p5","t p50","t p95","t max","fail","pos p50","pos p95","pos max","hdg p50","hdg p95");
+	for(int c = 0; c < cases; c++)
+	{
+		std::vector<double> times, pos, hdg;
+		int failed = 0;
+		for(int t = 0; t < trials; t++)
+		{
+			const TrialResult &r = results[size_t(c) * trials + t];
+			if(r.CompleteTime < 0) failed++;
+			else times.push_back(r.CompleteTime);
+			pos.push_back(hypot(r.X - nominal[c].X,r.Y - nominal[c].Y));
+			hdg.push_back(fabs(remainder(r.Heading - nominal[c].Heading,360.0)));
+		}
+		double maxTime = times.empty() ? 0.0 : *std::max_element(times.begin(),times.end());
+		printf("%-8i %-4s %7.2f %7.2f %7.2f %7.2f %6i  %7.2f %7.2f %7.2f  %7.1f %7.1f\n",c / kLayouts + 1,
+				Layouts[c % kLayouts],Percentile(times,5),Percentile(times,50),Percentile(times,95),
+				maxTime,failed,
+				Percentile(pos,50),Percentile(pos,95),*std::max_element(pos.begin(),pos.end()),
+				Percentile(hdg,50),Percentile(hdg,95));
+	}
+	int runs = cases * (trials + 1);
+	printf("%i runs on %i threads in %.2f s (%.0f runs/s), times in s, pose error in ft and degrees\n",
+			runs,pool.GetThreadCount(),secs,runs / secs);
+	return 0;
+}
+
+#endif
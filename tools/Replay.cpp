@@ -0,0 +1,241 @@
+/*
+ * Replay.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Runs the autonomous code against recorded telemetry (see Telemetry.h) and
+ *  checks that every cycle produces the same record bit for bit.  The
+ *  recorded clock and sensor values are fed back through ReplayRobotIO, so a
+ *  15 second auto replays in a few milliseconds.  A difference means the
+ *  code changed behaviour on that run: the first differing field is printed
+ *  along with the largest change in the drive outputs.  Only runs with the
+ *  profile in the 50Hz cycle can be replayed, the drive loop's ticks are not
+ *  recorded (simauto -r 0 writes them).
+ *
+ *  A thumbwheel 7 run needs the script it ran.  It is loaded from the path
+ *  in the file's header, or from -s, and a script that does not hash to the
+ *  recorded one is refused.
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/Replay.cpp -o replay -pthread
+ *     ./replay [-v] [-s script] telemetry.bin ...          -v prints the profile log
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "Robot.h"
+#include "Telemetry.h"
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+//RobotIO that plays back one telemetry record, commands are dropped
+class ReplayRobotIO : public RobotIO
+{
+public:
+	const TelemetryHeader *Header = NULL;
+	const TelemetryRecord *Record = NULL;
+
+	uint64_t GetFPGATime() { return Record->Time; }
+	double GetYaw() { return Record->Yaw; }
+	int GetLeftEncoder() { return Record->LeftEncoder; }
+	int GetRightEncoder() { return Record->RightEncoder; }
+	void ZeroEncoders() {}	//recorded counts are already zeroed
+	double GetArmPosition() { return Record->ArmPosition; }
+	bool GetLimitLiftHi() { return Record->LimitLiftHi; }
+	bool GetLimitLiftLo() { return Record->LimitLiftLo; }
+	bool GetThumbWheelBit(int bit) { return (Header->ThumbWheel & bit) == 0; }
+	std::string GetGameData() { return Header->GameData; }
+	void SetDrive(double, double) {}
+	void SetLift(double) {}
+	void SetArm(double) {}
+	void SetGrip(double) {}
+};
+
+struct ReplayResult
+{
+	int Cycles = 0;
+	int Differ = 0;
+	int FirstCycle = -1;
+	const char *FirstField = NULL;
+	double MaxOutput = 0.0;
+	double MaxCurve = 0.0;
+	double MaxDrive = 0.0;
+};
+
+static bool LoadFile(const char *path, std::vector<char> &data)
+{
+	FILE *file = fopen(path,"rb");
+	if(file == NULL) return false;
+	fseek(file,0,SEEK_END);
+	data.resize(ftell(file));
+	fseek(file,0,SEEK_SET);
+	bool ok = fread(data.data(),1,data.size(),file) == data.size();
+	fclose(file);
+	return ok;
+}
+
+//the file must have been written with this build's record layout
+static bool CheckSchema(const TelemetryHeader *header, size_t size)
+{
+	const TelemetryField *fields;
+	int count = Telemetry::GetSchema(&fields);
+	if(size < sizeof(TelemetryHeader) || strncmp(header->Magic,"FRCTLM1",8) != 0) return false;
+	if(header->HeaderSize != sizeof(TelemetryHeader) || header->RecordSize != sizeof(TelemetryRecord)) return false;
+	if(header->FieldCount != uint32_t(count)) return false;
+	for(int i = 0; i < count; i++)
+	{
+		if(strncmp(header->Fields[i].Name,fields[i].Name,sizeof(fields[i].Name)) != 0) return false;
+		if(header->Fields[i].Type != fields[i].Type || header->Fields[i].Offset != fields[i].Offset) return false;
+	}
+	return size >= sizeof(TelemetryHeader) + size_t(header->Capacity) * sizeof(TelemetryRecord);
+}
+
+//load the script a thumbwheel 7 run was recorded with, false if it can't be or it changed
+static bool LoadRecordedScript(Robot &robot, const TelemetryHeader *header, const char *script, const char *path)
+{
+	if(script == NULL && header->ScriptPath[0] != 0) script = header->ScriptPath;
+	if(script != NULL && robot.LoadScript(script) < 0)
+	{
+		printf("%s: can't load the script %s\n",path,script);
+		return false;
+	}
+	uint32_t hash = robot.GetScript()->GetHash();
+	if(hash != header->ScriptHash)
+	{
+		printf("%s: recorded with script %08x, %s is %08x\n",path,header->ScriptHash,
+				script != NULL ? script : "the loaded script",hash);
+		return false;
+	}
+	return true;
+}
+
+static const char *FirstDifference(const TelemetryRecord &a, const TelemetryRecord &b)
+{
+	static const int kTypeSize[] = {1,4,8,4,8};
+	const TelemetryField *fields;
+	int count = Telemetry::GetSchema(&fields);
+	for(int i = 0; i < count; i++)
+		if(memcmp((const char *)&a + fields[i].Offset,(const char *)&b + fields[i].Offset,kTypeSize[fields[i].Type]) != 0)
+			return fields[i].Name;
+	return NULL;
+}
+
+static void Compare(ReplayResult &result, int cycle, const TelemetryRecord &recorded, const TelemetryRecord &replayed)
+{
+	result.Cycles++;
+	const char *field = FirstDifference(recorded,replayed);
+	if(field == NULL) return;
+	result.Differ++;
+	if(result.FirstCycle < 0)
+	{
+		result.FirstCycle = cycle;
+		result.FirstField = field;
+	}
+	result.MaxOutput = fmax(result.MaxOutput,fabs(recorded.OutputMagnitude - replayed.OutputMagnitude));
+	result.MaxCurve = fmax(result.MaxCurve,fabs(recorded.Curve - replayed.Curve));
+	result.MaxDrive = fmax(result.MaxDrive,fmax(fabs(recorded.DriveLeft - replayed.DriveLeft),
+			fabs(recorded.DriveRight - replayed.DriveRight)));
+}
+
+static bool Replay(Robot &robot, ReplayRobotIO &io, const std::vector<char> &data, bool verbose, ReplayResult &result)
+{
+	const TelemetryHeader *header = (const TelemetryHeader *)data.data();
+	const TelemetryRecord *records = (const TelemetryRecord *)(data.data() + sizeof(TelemetryHeader));
+	uint64_t count = header->RecordCount;
+	uint64_t first = count > header->Capacity ? count - header->Capacity : 0;
+	io.Header = header;
+
+	//the autonomous run starts at its init record
+	uint64_t n = first;
+	while(n < count && records[n % header->Capacity].Mode != kModeAutonomousInit) n++;
+	if(n == count) return false;
+	io.Record = &records[n % header->Capacity];
+	robot.AutonomousInit();
+	Compare(result,0,*io.Record,*robot.GetLastRecord());
+
+	for(n++; n < count && records[n % header->Capacity].Mode == kModeAutonomous; n++)
+	{
+		io.Record = &records[n % header->Capacity];
+		robot.AutonomousPeriodic();
+		if(verbose) Logger::Flush();
+		Compare(result,result.Cycles,*io.Record,*robot.GetLastRecord());
+	}
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	bool verbose = false;
+	const char *script = NULL;
+	std::vector<const char *> paths;
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i],"-v") == 0) verbose = true;
+		else if(strcmp(argv[i],"-s") == 0 && i + 1 < argc) script = argv[++i];
+		else paths.push_back(argv[i]);
+	}
+	if(paths.empty())
+	{
+		printf("usage: replay [-v] [-s script] telemetry.bin ...\n");
+		return 2;
+	}
+
+	//one robot for every file, AutonomousInit must reset everything a run depends on
+	ReplayRobotIO io;
+	TelemetryRecord start = {};
+	io.Record = &start;
+	Robot robot;
+	robot.ControlInit(&io);
+
+	int failed = 0;
+	uint64_t cycles = 0;
+	auto begin = std::chrono::steady_clock::now();
+	for(const char *path : paths)
+	{
+		std::vector<char> data;
+		ReplayResult result;
+		if(!LoadFile(path,data) || !CheckSchema((const TelemetryHeader *)data.data(),data.size()))
+		{
+			printf("%s: not a telemetry file for this build\n",path);
+			failed++;
+			continue;
+		}
+		if(((const TelemetryHeader *)data.data())->DriveLoopRate != 0)
+		{
+			printf("%s: recorded with a %u Hz drive loop, only the 50Hz cycle is recorded\n",path,
+					((const TelemetryHeader *)data.data())->DriveLoopRate);
+			failed++;
+			continue;
+		}
+		const TelemetryHeader *header = (const TelemetryHeader *)data.data();
+		if(header->ThumbWheel == Robot::kScriptThumbWheel && !LoadRecordedScript(robot,header,script,path))
+		{
+			failed++;
+			continue;
+		}
+		if(!Replay(robot,io,data,verbose,result))
+		{
+			printf("%s: no autonomous run\n",path);
+			failed++;
+			continue;
+		}
+		cycles += result.Cycles;
+		if(result.Differ == 0)
+		{
+			printf("%s: %i cycles, exact\n",path,result.Cycles);
+			continue;
+		}
+		failed++;
+		printf("%s: %i cycles, %i differ, first at cycle %i (%s), max diff output %.4f curve %.4f drive %.4f\n",
+				path,result.Cycles,result.Differ,result.FirstCycle,result.FirstField,
+				result.MaxOutput,result.MaxCurve,result.MaxDrive);
+	}
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	printf("%zu files, %ju cycles in %.3f s (%.0fx real time), %i not exact\n",paths.size(),cycles,secs,
+			cycles * 0.02 / fmax(secs,1e-9),failed);
+	return failed > 0 ? 1 : 0;
+}
+
+#endif
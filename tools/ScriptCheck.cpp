@@ -0,0 +1,100 @@
+/*
+ * ScriptCheck.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Checks an AutoScript before it goes on the robot: prints the profile
+ *  steps and mechanism commands each game data layout runs, times the
+ *  parse, and with -o writes the binary form.  Build and run from the src
+ *  folder:
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/ScriptCheck.cpp -o scriptcheck -pthread
+ *     ./scriptcheck auto.txt [-o auto.bin]
+ *
+ *  Copy either file to /home/lvuser/auto.txt, the robot reloads it while
+ *  disabled.
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "AutoScript.h"
+#include "Logger.h"
+#include "Profile.h"
+#include "SimRobotIO.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+static const char *kCommandNames[] = {"MOVE","TURN","PAUSE","CURVE","SPLINE"};
+static const char *kActionNames[] = {"ARM","LIFT","EJECT"};
+static const char *kLayoutNames[AutoScript::kLayouts] = {"LL","RL","LR","RR"};
+
+int main(int argc, char **argv)
+{
+	if(argc < 2)
+	{
+		printf("usage: scriptcheck <script> [-o binary]\n");
+		return 1;
+	}
+	const char *output = argc > 3 && strcmp(argv[2],"-o") == 0 ? argv[3] : NULL;
+	SimRobotIO io;
+	Logger::Init(&io);
+	Logger::AttachThread();
+
+	AutoScript script;
+	if(script.LoadFile(argv[1]) < 0)
+	{
+		printf("%s: %s\n",argv[1],script.GetError());
+		return 1;
+	}
+	//parse time from the text already in memory, without the file read
+	FILE *file = fopen(argv[1],"rb");
+	static char text[AutoScript::kMaxText];
+	int length = fread(text,1,sizeof(text),file);
+	fclose(file);
+	AutoScript parsed;
+	if(parsed.Parse(text,length) < 0) printf("%s: %i commands, binary\n",argv[1],script.GetOpCount());
+	else
+	{
+		const int runs = 10000;
+		auto start = std::chrono::steady_clock::now();
+		for(int i = 0; i < runs; i++) parsed.Parse(text,length);
+		double us = std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+		printf("%s: %i commands, parse %.2f us\n",argv[1],script.GetOpCount(),us);
+	}
+
+	static Profile profile(&io);
+	for(int layout = 0; layout < AutoScript::kLayouts; layout++)
+	{
+		profile.Initialize();
+		profile.ClearProfile();
+		int steps = script.BuildProfile(&profile,layout);
+		printf("%sX:",kLayoutNames[layout]);
+		for(int i = 0; i < steps; i++)
+		{
+			const ProfileParams &step = profile.GetStep(i);
+			printf("  %s",kCommandNames[step.Command - kProfileMove]);
+			if(step.Command == kProfileTurn) printf(" %.1f",step.Turn.TgtHeading);
+			else if(step.Command == kProfilePause) printf(" %.0f",step.Pause.PauseTime);
+			else printf(" %.2f",step.Move.MaxSpeed < 0 ? step.Move.TgtDistance : -step.Move.TgtDistance);
+		}
+		const ScriptOp *actions[AutoScript::kMaxOps];
+		int count = script.GetActions(layout,actions,AutoScript::kMaxOps);
+		for(int i = 0; i < count; i++) printf("  %s %.2f",kActionNames[actions[i]->Code - kScriptArm],actions[i]->Args[0]);
+		printf("\n");
+	}
+	Logger::Flush();
+	if(output != NULL)
+	{
+		if(script.Save(output) < 0)
+		{
+			printf("could not write %s\n",output);
+			return 1;
+		}
+		printf("wrote %s\n",output);
+	}
+	return 0;
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * SimAuto.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Runs one autonomous routine headless against SimRobotIO and prints the
+ *  robot's track.  Build and run from the src folder:
+ *
+ *     g++ -std=c++14 -O2 -DROBOT_SIM -I. *.cpp tools/SimAuto.cpp -o simauto -pthread
+ *     ./simauto <thumbwheel> <gamedata> [-r hz] [-m [-f ms]] [-p] [-t] [-s script] [telemetry file]       e.g.  ./simauto 3 LRL
+ *
+ *  -r sets the drive loop rate (200Hz like the robot by default), 0 runs the
+ *  profile in AutonomousPeriodic, which is what the replay tool expects.
+ *  -m streams straight line profiles to mock Talons (SimProfileBuffer) that
+ *  run their own loop every 1ms of sim time, -f sets how often the stream's
+ *  fill runs (5ms default, slower shows the underrun reporting).
+ *  -s loads an AutoScript (text or binary) for thumbwheel 7.
+ *  -p drives the side switch deliveries (3-6 on the switch) as one spline
+ *  each instead of MOVE/TURN/MOVE (Robot::AutoUseSplines), -t also tracks
+ *  them with the Ramsete follower (Profile::ProfileFollower).
+ *
+ */
+
+#ifdef ROBOT_SIM
+
+#include "Robot.h"
+#include "SimRobotIO.h"
+#include "MotionProfileBuffer.h"
+#include "MotionStreamer.h"
+#include <stdlib.h>
+#include <string.h>
+
+//one 20ms cycle of physics in 5ms steps (or finer), with the drive loop ticks spread through it
+static void StepCycle(Robot &robot, SimRobotIO &io)
+{
+	int ticks = robot.GetDriveLoopTicks();
+	int steps = ticks > 4 ? ticks : 4;
+	for(int i = 0; i < steps; i++)
+	{
+		if(ticks > 0 && (i * ticks) % steps < ticks) robot.DriveLoopTick();
+		io.Step(0.02 / steps);
+	}
+}
+
+//the same 20ms cycle in 1ms steps, with the mock Talons driving while they are in motion profile mode
+//(their outputs go to SetDrive as they are, like the Talons' own)
+//and the stream's fill every fillMs
+static void StepCycle(Robot &robot, SimRobotIO &io, SimProfileBuffer &left, SimProfileBuffer &right,
+		MotionStreamer &stream, int fillMs)
+{
+	int ticks = robot.GetDriveLoopTicks();
+	for(int i = 0; i < 20; i++)
+	{
+		if(ticks > 0 && (i * ticks) % 20 < ticks) robot.DriveLoopTick();
+		if((io.GetFPGATime() / 1000) % fillMs == 0) stream.Service();
+		MotionBufferStatus status;
+		left.GetStatus(&status);
+		if(status.Mode != kMotionDisable)
+			io.SetDrive(left.GetOutput(io.GetLeftEncoder()),right.GetOutput(io.GetRightEncoder()));
+		io.Step(0.001);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int thumbWheel = argc > 1 ? atoi(argv[1]) : 1;
+	const char *gameData = argc > 2 ? argv[2] : "LLL";
+	double rate = DriveLoop::kDefaultRate;
+	bool streamMoves = false;
+	int fillMs = 5;
+	const char *path = NULL;
+	const char *script = NULL;
+	bool splines = false;
+	bool follower = false;
+	for(int i = 3; i < argc; i++)
+	{
+		if(strcmp(argv[i],"-r") == 0 && i + 1 < argc) rate = atof(argv[++i]);
+		else if(strcmp(argv[i],"-m") == 0) streamMoves = true;
+		else if(strcmp(argv[i],"-p") == 0) splines = true;
+		else if(strcmp(argv[i],"-t") == 0) follower = true;
+		else if(strcmp(argv[i],"-s") == 0 && i + 1 < argc) script = argv[++i];
+		else if(strcmp(argv[i],"-f") == 0 && i + 1 < argc) fillMs = atoi(argv[++i]) > 0 ? atoi(argv[i]) : 1;
+		else path = argv[i];
+	}
+
+	SimRobotIO io;
+	io.SetThumbWheel(thumbWheel);
+	io.SetGameData(gameData);
+
+	Robot robot;
+	robot.ControlInit(&io,rate);
+	if(splines) robot.SetAutoUseSplines(true);
+	if(follower) robot.SetAutoFollower(true);
+	if(path != NULL && !robot.OpenTelemetry(path)) return 1;
+	if(script != NULL && robot.LoadScript(script) < 0)
+	{
+		//the robot only logs the line, load it again for the message
+		AutoScript check;
+		check.LoadFile(script);
+		printf("%s: %s\n",script,check.GetError());
+		return 1;
+	}
+	//gains from the default Profile, same as RobotInit
+	double kP, kF;
+	MotionStreamer::GetTalonGains(Profile(&io),SimParams().FeetPerPulse,&kP,&kF);
+	SimProfileBuffer left(&io,kP,kF);
+	SimProfileBuffer right(&io,kP,kF);
+	MotionStreamer stream(&io,&left,&right,SimParams().FeetPerPulse);
+	stream.SetDirections(Robot::kLeftEncoderSign,Robot::kRightEncoderSign);
+	if(streamMoves) robot.AttachStream(&stream);
+	robot.AutonomousInit();
+
+	//15 second autonomous period, 20ms TimedRobot loop
+	for(int cycle = 0; cycle < 750; cycle++)
+	{
+		robot.AutonomousPeriodic();
+		if(streamMoves) StepCycle(robot,io,left,right,stream,fillMs);
+		else StepCycle(robot,io);
+		Logger::Flush();
+		if(cycle % 25 == 0)
+			printf("t=%5.2f  x=%6.2f  y=%6.2f  hdg=%7.2f  lift=%4.2f  arm=%5.2f  grip=%5.2f\n",
+					io.GetFPGATime() / 1000000.0,io.GetX(),io.GetY(),io.GetHeading(),
+					io.GetLiftPosition(),io.GetArmPosition(),io.GetGripSpeed());
+	}
+	printf("END   x=%6.2f  y=%6.2f  hdg=%7.2f\n",io.GetX(),io.GetY(),io.GetHeading());
+	const Pose2d &pose = robot.GetPose();
+	printf("ODOM  x=%6.2f  y=%6.2f  hdg=%7.2f\n",pose.X,pose.Y,pose.Heading);
+	if(streamMoves) printf("STREAM underruns=%u\n",stream.GetUnderruns());
+	return 0;
+}
+
+#endif